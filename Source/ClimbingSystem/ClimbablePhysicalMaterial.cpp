@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbablePhysicalMaterial.h"
+
+void UClimbablePhysicalMaterial::ApplyTo(FClimbingSurfaceRules& Rules) const
+{
+	Rules.bClimbable = bClimbable;
+	Rules.SpeedScale = ClimbSpeedScale;
+	if (bOverrideMinClimbAngle)
+	{
+		Rules.MinClimbAngle = MinClimbAngle;
+	}
+	if (bOverrideMaxClimbAngle)
+	{
+		Rules.MaxClimbAngle = MaxClimbAngle;
+	}
+}
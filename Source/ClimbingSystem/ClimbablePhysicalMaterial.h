@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingSolver.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "ClimbablePhysicalMaterial.generated.h"
+
+/** Physical material with climbing rules, for surfaces that climb differently or can't be climbed at all */
+UCLASS()
+class UClimbablePhysicalMaterial : public UPhysicalMaterial
+{
+	GENERATED_BODY()
+
+public:
+	/** Can the surface be grabbed and climbed on? */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Climbing)
+	bool bClimbable = true;
+
+	/** Scales MaxClimbSpeed on this surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Climbing, meta=(ClampMin="0", UIMin="0", EditCondition="bClimbable"))
+	float ClimbSpeedScale = 1.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Climbing, meta=(InlineEditConditionToggle))
+	bool bOverrideMinClimbAngle = false;
+
+	/** Replaces MinClimbAngle of the climber on this surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Climbing, meta=(EditCondition="bOverrideMinClimbAngle"))
+	float MinClimbAngle = -75.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Climbing, meta=(InlineEditConditionToggle))
+	bool bOverrideMaxClimbAngle = false;
+
+	/** Replaces MaxClimbAngle of the climber on this surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Climbing, meta=(EditCondition="bOverrideMaxClimbAngle"))
+	float MaxClimbAngle = 45.f;
+
+	/** Changes the rules of the climber with the ones of this material */
+	void ApplyTo(FClimbingSurfaceRules& Rules) const;
+};
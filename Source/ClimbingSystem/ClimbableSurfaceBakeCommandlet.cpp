@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbableSurfaceBakeCommandlet.h"
+
+#include "ClimbableSurfaceBuilder.h"
+#include "ClimbableSurfaceIndex.h"
+#include "ClimbingSystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+UClimbableSurfaceBakeCommandlet::UClimbableSurfaceBakeCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UClimbableSurfaceBakeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbable surface bake: missing -Map=<package name>"));
+		return 1;
+	}
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbable surface bake: can't load the map %s"), *MapName);
+		return 1;
+	}
+
+	// The map has to be initialized with a physics scene for the sampling traces
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreatePhysicsScene(true)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false));
+	}
+	World->UpdateWorldComponents(true, false);
+	World->LoadSecondaryLevels();
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+	FClimbableSurfaceBuildSettings Settings;
+	FParse::Value(*Params, TEXT("CellSize="), Settings.CellSize);
+	Settings.CellSize = FMath::Max(Settings.CellSize, 10.f);
+
+	const FString IndexPackageName = MapPackage->GetName() + UClimbableSurfaceIndex::AssetSuffix;
+	const FString IndexName = FPackageName::GetShortName(IndexPackageName);
+	UPackage* IndexPackage = CreatePackage(*IndexPackageName);
+	IndexPackage->FullyLoad();
+
+	UClimbableSurfaceIndex* Index = FindObject<UClimbableSurfaceIndex>(IndexPackage, *IndexName);
+	if (!Index)
+	{
+		Index = NewObject<UClimbableSurfaceIndex>(IndexPackage, *IndexName, RF_Public | RF_Standalone);
+	}
+
+	FClimbableSurfaceBuilder Builder(World, Settings);
+	Builder.Build(*Index);
+
+	World->RemoveFromRoot();
+
+	IndexPackage->MarkPackageDirty();
+	const FString FileName = FPackageName::LongPackageNameToFilename(IndexPackageName, FPackageName::GetAssetPackageExtension());
+	if (!UPackage::SavePackage(IndexPackage, Index, RF_Public | RF_Standalone, *FileName))
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbable surface bake: can't save %s"), *FileName);
+		return 1;
+	}
+
+	UE_LOG(LogClimbing, Display, TEXT("Climbable surface index saved to %s"), *FileName);
+	return 0;
+#else
+	UE_LOG(LogClimbing, Error, TEXT("Climbable surface bake: only available in editor builds"));
+	return 1;
+#endif
+}
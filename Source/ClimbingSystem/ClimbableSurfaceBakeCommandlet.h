@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbableSurfaceBakeCommandlet.generated.h"
+
+/**
+ * Bakes the climbable surface index of a map, saved next to it as <Map>_ClimbIndex and
+ * loaded by UClimbingSubsystem when the map is played. Has to be run again when the static
+ * geometry of the map changes.
+ *
+ * UE4Editor-Cmd ClimbingSystem.uproject -run=ClimbableSurfaceBake -Map=/Game/ThirdPersonCPP/Maps/ThirdPersonExampleMap
+ *     [-CellSize=<size>]
+ */
+UCLASS()
+class UClimbableSurfaceBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbableSurfaceBakeCommandlet();
+
+	//Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//End UCommandlet Interface
+};
@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbableSurfaceBuilder.h"
+
+#include "ClimbablePhysicalMaterial.h"
+#include "ClimbableSurfaceIndex.h"
+#include "ClimbingMovementComponent.h"
+#include "ClimbingSolver.h"
+#include "ClimbingSystem.h"
+#include "ClimbingSystemCharacter.h"
+#include "EngineUtils.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+FClimbableSurfaceBuildSettings::FClimbableSurfaceBuildSettings()
+{
+	const UClimbingMovementComponent* Movement = GetDefault<UClimbingMovementComponent>();
+	const AClimbingSystemCharacter* Character = GetDefault<AClimbingSystemCharacter>();
+
+	CellSize = 50.f;
+	MinClimbAngle = Movement->MinClimbAngle;
+	MaxClimbAngle = Movement->MaxClimbAngle;
+	MaxTurnAngle = Movement->MaxTurnAngle;
+	PlanarTolerance = 10.f;
+	CapsuleRadius = Character->GetCapsuleComponent()->GetScaledCapsuleRadius();
+	CapsuleHalfHeight = Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	NumDirections = 8;
+}
+
+FClimbableSurfaceBuilder::FClimbableSurfaceBuilder(UWorld* InWorld, const FClimbableSurfaceBuildSettings& InSettings)
+	: World(InWorld)
+	, Settings(InSettings)
+{
+	check(World);
+}
+
+void FClimbableSurfaceBuilder::Build(UClimbableSurfaceIndex& OutIndex)
+{
+	Cells.Reset();
+
+	// Only geometry that can't move at runtime is baked, movable objects are always traced
+	int32 NumComponents = 0;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> Components(*It);
+		for (UPrimitiveComponent* Component : Components)
+		{
+			if (Component->Mobility != EComponentMobility::Movable && Component->IsRegistered() &&
+			    Component->IsQueryCollisionEnabled() && Component->GetCollisionResponseToChannel(ECC_Climbable) == ECR_Block)
+			{
+				SampleComponent(Component);
+				++NumComponents;
+			}
+		}
+	}
+
+	OutIndex.CellSize = Settings.CellSize;
+	OutIndex.CapsuleRadius = Settings.CapsuleRadius;
+	OutIndex.CapsuleHalfHeight = Settings.CapsuleHalfHeight;
+	BuildPatches(OutIndex);
+	OutIndex.RebuildLookup();
+	FlagEdges(OutIndex);
+	FlagLedges(OutIndex);
+
+	UE_LOG(LogClimbing, Display, TEXT("Baked %d climbing surface patches from %d static components"), OutIndex.Patches.Num(), NumComponents);
+}
+
+void FClimbableSurfaceBuilder::SampleComponent(UPrimitiveComponent* Component)
+{
+	const FBoxSphereBounds& Bounds = Component->Bounds;
+	const float Extent = Bounds.SphereRadius + Settings.CellSize;
+	const int32 NumSteps = FMath::CeilToInt(2.f * Extent / Settings.CellSize);
+
+	TArray<FVector> Directions;
+	for (int32 Index = 0; Index < Settings.NumDirections; ++Index)
+	{
+		const float Yaw = 360.f * Index / Settings.NumDirections;
+		Directions.Add(FRotator(0.f, Yaw, 0.f).Vector());
+	}
+	Directions.Add(FVector::UpVector);
+	Directions.Add(-FVector::UpVector);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbableSurfaceBake), false);
+	Params.bReturnPhysicalMaterial = true;
+	for (const FVector& Direction : Directions)
+	{
+		FVector AxisU, AxisV;
+		Direction.FindBestAxisVectors(AxisU, AxisV);
+
+		// A grid of parallel rays crossing the whole component
+		for (int32 StepU = 0; StepU <= NumSteps; ++StepU)
+		{
+			for (int32 StepV = 0; StepV <= NumSteps; ++StepV)
+			{
+				const FVector Offset = AxisU * (StepU * Settings.CellSize - Extent) + AxisV * (StepV * Settings.CellSize - Extent);
+				const FVector Start = Bounds.Origin + Offset - Direction * Extent;
+				const FVector End = Bounds.Origin + Offset + Direction * Extent;
+
+				FHitResult Hit;
+				if (!Component->LineTraceComponent(Hit, Start, End, Params))
+				{
+					continue;
+				}
+
+				// Hidden behind something else, the other component will be sampled from here
+				FHitResult WorldHit;
+				if (World->LineTraceSingleByChannel(WorldHit, Start, End, ECC_Climbable, Params) && WorldHit.GetComponent() != Component)
+				{
+					continue;
+				}
+
+				const FIntVector CellKey(
+					FMath::FloorToInt(Hit.Location.X / Settings.CellSize),
+					FMath::FloorToInt(Hit.Location.Y / Settings.CellSize),
+					FMath::FloorToInt(Hit.Location.Z / Settings.CellSize));
+				FCell& Cell = Cells.FindOrAdd(CellKey);
+				if (Cell.Component.IsValid() && Cell.Component.Get() != Component)
+				{
+					Cell.bRejected = true;
+				}
+				// The rules of a climbing material are not baked, those surfaces keep being traced
+				if (Cast<UClimbablePhysicalMaterial>(Hit.PhysMaterial.Get()))
+				{
+					Cell.bRejected = true;
+				}
+				Cell.Component = Component;
+				Cell.Samples.Add({Hit.Location, Hit.Normal.GetSafeNormal()});
+			}
+		}
+	}
+}
+
+void FClimbableSurfaceBuilder::BuildPatches(UClimbableSurfaceIndex& OutIndex) const
+{
+	OutIndex.Patches.Reset();
+	const float MinNormalDot = FMath::Cos(FMath::DegreesToRadians(Settings.PlanarTolerance));
+
+	for (const TPair<FIntVector, FCell>& Pair : Cells)
+	{
+		const FCell& Cell = Pair.Value;
+		if (Cell.bRejected || Cell.Samples.Num() == 0)
+		{
+			continue;
+		}
+
+		FVector Location = FVector::ZeroVector;
+		FVector Normal = FVector::ZeroVector;
+		for (const FSample& Sample : Cell.Samples)
+		{
+			Location += Sample.Location;
+			Normal += Sample.Normal;
+		}
+		Location /= Cell.Samples.Num();
+		Normal = Normal.GetSafeNormal();
+
+		// A single plane has to stand for every sample of the cell
+		bool bPlanar = !Normal.IsZero();
+		for (const FSample& Sample : Cell.Samples)
+		{
+			if (!bPlanar)
+			{
+				break;
+			}
+			bPlanar = FVector::DotProduct(Sample.Normal, Normal) >= MinNormalDot &&
+				FMath::Abs(FVector::DotProduct(Sample.Location - Location, Normal)) <= 2.f;
+		}
+		if (!bPlanar)
+		{
+			continue;
+		}
+
+		const float ClimbAngle = FClimbingSolver::GetClimbAngle(Normal);
+		const bool bClimbable = ClimbAngle >= Settings.MinClimbAngle && ClimbAngle <= Settings.MaxClimbAngle;
+
+		FClimbableSurfacePatch& Patch = OutIndex.Patches.AddDefaulted_GetRef();
+		Patch.Cell = Pair.Key;
+		Patch.Location = Location;
+		Patch.Normal = Normal;
+		Patch.Flags = static_cast<uint8>(bClimbable ? EClimbableSurfaceFlags::Climbable : EClimbableSurfaceFlags::None);
+	}
+}
+
+void FClimbableSurfaceBuilder::FlagEdges(UClimbableSurfaceIndex& OutIndex) const
+{
+	for (FClimbableSurfacePatch& Patch : OutIndex.Patches)
+	{
+		bool bEdge = false;
+		for (int32 X = -1; X <= 1 && !bEdge; ++X)
+		{
+			for (int32 Y = -1; Y <= 1 && !bEdge; ++Y)
+			{
+				for (int32 Z = -1; Z <= 1 && !bEdge; ++Z)
+				{
+					const FIntVector NeighbourKey = Patch.Cell + FIntVector(X, Y, Z);
+					if (const FClimbableSurfacePatch* Neighbour = OutIndex.FindPatch(NeighbourKey))
+					{
+						bEdge = FClimbingSolver::GetTurnAngle(Patch.Normal, Neighbour->Normal) > Settings.MaxTurnAngle;
+					}
+					else if (const FCell* Cell = Cells.Find(NeighbourKey))
+					{
+						// Geometry that could not be baked is next to this patch
+						bEdge = Cell->Samples.Num() > 0;
+					}
+				}
+			}
+		}
+
+		if (bEdge)
+		{
+			Patch.Flags |= static_cast<uint8>(EClimbableSurfaceFlags::Edge);
+		}
+	}
+}
+
+void FClimbableSurfaceBuilder::FlagLedges(UClimbableSurfaceIndex& OutIndex) const
+{
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(Settings.CapsuleRadius, Settings.CapsuleHalfHeight);
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbableSurfaceBake), false);
+
+	for (FClimbableSurfacePatch& Patch : OutIndex.Patches)
+	{
+		if (!Patch.HasFlag(EClimbableSurfaceFlags::Climbable))
+		{
+			continue;
+		}
+
+		// Top of the wall: the cell above holds no surface the climber could keep going on
+		const FClimbableSurfacePatch* Above = OutIndex.FindPatch(Patch.Cell + FIntVector(0, 0, 1));
+		if (Above && FClimbingSolver::GetTurnAngle(Patch.Normal, Above->Normal) <= Settings.MaxTurnAngle)
+		{
+			continue;
+		}
+
+		// Same clearance test as the vault at runtime, for a climber whose probe above just left the wall
+		const FVector ClimberLocation = Patch.Location + Patch.Normal * Settings.CapsuleRadius - FVector::UpVector * Settings.CapsuleHalfHeight;
+		const FVector VaultLocation = ClimberLocation + FVector::UpVector * Settings.CapsuleHalfHeight * 2.f - Patch.Normal * Settings.CapsuleRadius * 2.f;
+
+		FHitResult Hit;
+		if (!World->SweepSingleByChannel(Hit, VaultLocation, VaultLocation, FQuat::Identity, ECC_Climbable, Capsule, Params))
+		{
+			Patch.Flags |= static_cast<uint8>(EClimbableSurfaceFlags::Ledge);
+		}
+	}
+}
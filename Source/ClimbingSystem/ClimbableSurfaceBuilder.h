@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UClimbableSurfaceIndex;
+class UPrimitiveComponent;
+class UWorld;
+
+/** Settings of a climbable surface bake, defaults come from the climbing character and its movement */
+struct FClimbableSurfaceBuildSettings
+{
+	FClimbableSurfaceBuildSettings();
+
+	float CellSize;
+
+	/** Angle rules of UClimbingMovementComponent */
+	float MinClimbAngle;
+	float MaxClimbAngle;
+	float MaxTurnAngle;
+
+	/** Max angle in degrees between the samples of a cell for it to be stored as a single plane */
+	float PlanarTolerance;
+
+	/** Capsule of the climber, used for the vault clearance test */
+	float CapsuleRadius;
+	float CapsuleHalfHeight;
+
+	/** Number of horizontal directions each component is sampled from, plus straight up and down */
+	int32 NumDirections;
+};
+
+/**
+ * Scans the static geometry of a world with line traces and bakes it in a UClimbableSurfaceIndex:
+ * planar cells become patches, classified with the climbing angle rules, and the top of the walls
+ * that pass the vault clearance test are flagged as ledges.
+ */
+class FClimbableSurfaceBuilder
+{
+public:
+	FClimbableSurfaceBuilder(UWorld* InWorld, const FClimbableSurfaceBuildSettings& InSettings);
+
+	/** Replaces the patches of the index with the ones of the world */
+	void Build(UClimbableSurfaceIndex& OutIndex);
+
+private:
+	struct FSample
+	{
+		FVector Location;
+		FVector Normal;
+	};
+
+	struct FCell
+	{
+		TArray<FSample> Samples;
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		/** More than one component, a non planar surface or a climbing material, left to live traces */
+		bool bRejected = false;
+	};
+
+	/** Traces a component from every direction and stores the samples that hit it */
+	void SampleComponent(UPrimitiveComponent* Component);
+
+	/** Turns the planar cells in patches */
+	void BuildPatches(UClimbableSurfaceIndex& OutIndex) const;
+
+	/** Flags patches next to a turn sharper than MaxTurnAngle or to geometry that was not baked */
+	void FlagEdges(UClimbableSurfaceIndex& OutIndex) const;
+
+	/** Flags the top patches of climbable walls with enough space above them to vault */
+	void FlagLedges(UClimbableSurfaceIndex& OutIndex) const;
+
+	UWorld* World;
+	FClimbableSurfaceBuildSettings Settings;
+	TMap<FIntVector, FCell> Cells;
+};
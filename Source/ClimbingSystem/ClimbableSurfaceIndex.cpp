@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbableSurfaceIndex.h"
+
+const TCHAR* UClimbableSurfaceIndex::AssetSuffix = TEXT("_ClimbIndex");
+
+void UClimbableSurfaceIndex::PostLoad()
+{
+	Super::PostLoad();
+	RebuildLookup();
+}
+
+void UClimbableSurfaceIndex::RebuildLookup()
+{
+	CellToPatch.Reset();
+	CellToPatch.Reserve(Patches.Num());
+	for (int32 Index = 0; Index < Patches.Num(); ++Index)
+	{
+		CellToPatch.Add(Patches[Index].Cell, Index);
+	}
+}
+
+FIntVector UClimbableSurfaceIndex::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+const FClimbableSurfacePatch* UClimbableSurfaceIndex::FindPatch(const FIntVector& Cell) const
+{
+	const int32* Index = CellToPatch.Find(Cell);
+	return Index ? &Patches[*Index] : nullptr;
+}
+
+bool UClimbableSurfaceIndex::Raycast(const FVector& Start, const FVector& End, bool bTrustEdges, FHitResult& OutHit) const
+{
+	const FVector Segment = End - Start;
+	const float Length = Segment.Size();
+	if (Length <= KINDA_SMALL_NUMBER || CellSize <= 0.f)
+	{
+		return false;
+	}
+
+	// Walk the cells crossed by the segment, in order, and stop at the first patch it goes through
+	const int32 NumSteps = FMath::CeilToInt(Length / (CellSize * 0.25f));
+	FIntVector LastCell(MAX_int32);
+	for (int32 Step = 0; Step <= NumSteps; ++Step)
+	{
+		const FIntVector Cell = GetCell(Start + Segment * (static_cast<float>(Step) / NumSteps));
+		if (Cell == LastCell)
+		{
+			continue;
+		}
+		LastCell = Cell;
+
+		const FClimbableSurfacePatch* Patch = FindPatch(Cell);
+		if (!Patch || (!bTrustEdges && Patch->HasFlag(EClimbableSurfaceFlags::Edge)))
+		{
+			continue;
+		}
+
+		const float Denominator = FVector::DotProduct(Segment, Patch->Normal);
+		if (FMath::IsNearlyZero(Denominator))
+		{
+			continue;
+		}
+
+		const float Time = FVector::DotProduct(Patch->Location - Start, Patch->Normal) / Denominator;
+		if (Time < 0.f || Time > 1.f)
+		{
+			continue;
+		}
+
+		// The plane only stands for the surface inside its own cell
+		const FVector Location = Start + Segment * Time;
+		const FVector CellMin = FVector(Cell) * CellSize;
+		const FBox CellBox(CellMin - FVector(1.f), CellMin + FVector(CellSize + 1.f));
+		if (!CellBox.IsInside(Location))
+		{
+			continue;
+		}
+
+		OutHit = FHitResult(Start, End);
+		OutHit.bBlockingHit = true;
+		OutHit.Time = Time;
+		OutHit.Distance = Length * Time;
+		OutHit.Location = Location;
+		OutHit.ImpactPoint = Location;
+		OutHit.Normal = Patch->Normal;
+		OutHit.ImpactNormal = Patch->Normal;
+		return true;
+	}
+
+	return false;
+}
+
+bool UClimbableSurfaceIndex::HasLedgeAbove(const FVector& WallLocation, float Height, float Radius, float HalfHeight) const
+{
+	// The clearance test was baked with a given capsule, a bigger one may not fit
+	if (Radius > CapsuleRadius || HalfHeight > CapsuleHalfHeight)
+	{
+		return false;
+	}
+
+	const FIntVector BaseCell = GetCell(WallLocation);
+	const int32 NumCells = FMath::CeilToInt(Height / CellSize);
+	for (int32 Offset = 0; Offset <= NumCells; ++Offset)
+	{
+		const FClimbableSurfacePatch* Patch = FindPatch(BaseCell + FIntVector(0, 0, Offset));
+		if (Patch && Patch->HasFlag(EClimbableSurfaceFlags::Ledge))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
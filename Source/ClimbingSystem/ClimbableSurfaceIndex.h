@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ClimbableSurfaceIndex.generated.h"
+
+/** Flags of a baked surface patch */
+enum class EClimbableSurfaceFlags : uint8
+{
+	None		= 0,
+	/** The climb angle of the patch is between MinClimbAngle and MaxClimbAngle */
+	Climbable	= 1 << 0,
+	/** A neighbour patch turns by more than MaxTurnAngle, probes ahead of it have to be traced */
+	Edge		= 1 << 1,
+	/** Top of a wall with enough space above it to vault on */
+	Ledge		= 1 << 2,
+};
+ENUM_CLASS_FLAGS(EClimbableSurfaceFlags);
+
+/** Planar piece of static geometry contained in a cell of the index */
+USTRUCT()
+struct FClimbableSurfacePatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FIntVector Cell = FIntVector::ZeroValue;
+
+	/** Point on the surface, inside the cell */
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector Normal = FVector::ZeroVector;
+
+	/** EClimbableSurfaceFlags */
+	UPROPERTY()
+	uint8 Flags = 0;
+
+	bool HasFlag(EClimbableSurfaceFlags Flag) const { return EnumHasAnyFlags(static_cast<EClimbableSurfaceFlags>(Flags), Flag); }
+};
+
+/**
+ * Sparse grid of the static surfaces of a level, baked offline by the ClimbableSurfaceBake commandlet.
+ * Climbing probes are answered from the patches first and only traced when the index can't tell.
+ */
+UCLASS()
+class UClimbableSurfaceIndex : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Size of the cells of the grid */
+	UPROPERTY(VisibleAnywhere, Category=Climbing)
+	float CellSize = 50.f;
+
+	/** Capsule used for the vault clearance test of the ledges, bigger capsules can't trust the ledge flag */
+	UPROPERTY(VisibleAnywhere, Category=Climbing)
+	float CapsuleRadius = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category=Climbing)
+	float CapsuleHalfHeight = 0.f;
+
+	/** One patch for each cell that contains planar static geometry */
+	UPROPERTY()
+	TArray<FClimbableSurfacePatch> Patches;
+
+	/** Suffix of the index asset next to the map it was baked from */
+	static const TCHAR* AssetSuffix;
+
+	/** Rebuilds the lookup from cell to patch, called after loading or baking */
+	void RebuildLookup();
+
+	/** Finds the first patch crossed by a segment
+	 *  @param bTrustEdges If false, patches flagged as Edge are not returned
+	 *  @return True if OutHit holds a hit on a baked patch. False means the index can't tell, not that there is nothing
+	 */
+	bool Raycast(const FVector& Start, const FVector& End, bool bTrustEdges, FHitResult& OutHit) const;
+
+	/** Checks if there is a ledge to vault on in the column of cells above a wall location
+	 *  @param Height How far above the location to look for the ledge
+	 */
+	bool HasLedgeAbove(const FVector& WallLocation, float Height, float Radius, float HalfHeight) const;
+
+	const FClimbableSurfacePatch* FindPatch(const FIntVector& Cell) const;
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	//Begin UObject Interface
+	virtual void PostLoad() override;
+	//End UObject Interface
+
+private:
+	TMap<FIntVector, int32> CellToPatch;
+};
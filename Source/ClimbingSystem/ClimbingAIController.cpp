@@ -0,0 +1,10 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingAIController.h"
+
+#include "ClimbingPathFollowingComponent.h"
+
+AClimbingAIController::AClimbingAIController(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UClimbingPathFollowingComponent>(TEXT("PathFollowingComponent")))
+{
+}
@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "ClimbingAIController.generated.h"
+
+/** AI controller following its paths with UClimbingPathFollowingComponent, to climb along the climb links */
+UCLASS()
+class AClimbingAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AClimbingAIController(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingAnimBlueprintFixupCommandlet.h"
+
+#include "ClimbingSystem.h"
+#include "Animation/AnimBlueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Engine/EngineTypes.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#if WITH_EDITOR
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#endif
+
+UClimbingAnimBlueprintFixupCommandlet::UClimbingAnimBlueprintFixupCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UClimbingAnimBlueprintFixupCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString PackageName = TEXT("/Game/Mannequin/Animations/ThirdPerson_AnimBP");
+	FParse::Value(*Params, TEXT("AnimBlueprint="), PackageName);
+
+	const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+	UAnimBlueprint* AnimBlueprint = LoadObject<UAnimBlueprint>(nullptr, *ObjectPath);
+	if (!AnimBlueprint)
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing Anim Blueprint fixup: can't load the Anim Blueprint %s"), *ObjectPath);
+		return 1;
+	}
+
+	// Constants the movement mode is compared against, the transition rules of the state machines included
+	const UEnum* MovementModeEnum = StaticEnum<EMovementMode>();
+	const FString FlyingName = MovementModeEnum->GetNameStringByValue(MOVE_Flying);
+	const FString CustomName = MovementModeEnum->GetNameStringByValue(MOVE_Custom);
+
+	TArray<UEdGraph*> Graphs;
+	AnimBlueprint->GetAllGraphs(Graphs);
+
+	int32 NumPins = 0;
+	for (UEdGraph* Graph : Graphs)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				if (Pin->Direction == EGPD_Input && Pin->LinkedTo.Num() == 0 &&
+				    Pin->PinType.PinSubCategoryObject == MovementModeEnum && Pin->DefaultValue == FlyingName)
+				{
+					Node->Modify();
+					Pin->DefaultValue = CustomName;
+					Node->PinDefaultValueChanged(Pin);
+					++NumPins;
+				}
+			}
+		}
+	}
+
+	if (NumPins == 0)
+	{
+		UE_LOG(LogClimbing, Display, TEXT("Climbing Anim Blueprint fixup: %s does not test MOVE_Flying, nothing to do"), *ObjectPath);
+		return 0;
+	}
+
+	FBlueprintEditorUtils::MarkBlueprintAsModified(AnimBlueprint);
+	FKismetEditorUtilities::CompileBlueprint(AnimBlueprint);
+	if (AnimBlueprint->Status == BS_Error)
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing Anim Blueprint fixup: %s does not compile, it was not saved"), *ObjectPath);
+		return 1;
+	}
+
+	UPackage* Package = AnimBlueprint->GetOutermost();
+	const FString FileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+	if (!UPackage::SavePackage(Package, AnimBlueprint, RF_Public | RF_Standalone, *FileName))
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing Anim Blueprint fixup: can't save %s"), *FileName);
+		return 1;
+	}
+
+	UE_LOG(LogClimbing, Display, TEXT("Climbing Anim Blueprint fixup: %d MOVE_Flying tests of %s changed to MOVE_Custom"), NumPins, *ObjectPath);
+	return 0;
+#else
+	UE_LOG(LogClimbing, Error, TEXT("Climbing Anim Blueprint fixup: only available in editor builds"));
+	return 1;
+#endif
+}
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbingAnimBlueprintFixupCommandlet.generated.h"
+
+/**
+ * Moves an Anim Blueprint written for the old climbing, that switched the character to MOVE_Flying, to the
+ * climbing movement modes: every MOVE_Flying the graphs compare the movement mode against becomes MOVE_Custom,
+ * the mode of climbing and hanging. The blueprint is compiled and saved, run it once on the sample content.
+ *
+ * UE4Editor-Cmd ClimbingSystem.uproject -run=ClimbingAnimBlueprintFixup [-AnimBlueprint=/Game/Mannequin/Animations/ThirdPerson_AnimBP]
+ */
+UCLASS()
+class UClimbingAnimBlueprintFixupCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingAnimBlueprintFixupCommandlet();
+
+	//Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//End UCommandlet Interface
+};
@@ -0,0 +1,194 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingAnimInstance.h"
+
+#include "ClimbingMovementComponent.h"
+#include "ClimbingStats.h"
+#include "ClimbingSystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+
+void FClimbingAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	const ACharacter* Character = Cast<ACharacter>(InAnimInstance->TryGetPawnOwner());
+	const UClimbingMovementComponent* Movement = Character ? Cast<UClimbingMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+	if (!Movement)
+	{
+		Velocity = FVector::ZeroVector;
+		Acceleration = FVector::ZeroVector;
+		bIsClimbing = false;
+		bIsHanging = false;
+		bIsVaulting = false;
+		bIsFalling = false;
+		LimbTraces.Reset();
+		return;
+	}
+
+	Velocity = Movement->Velocity;
+	Acceleration = Movement->GetCurrentAcceleration();
+	RightVector = Character->GetActorRightVector();
+	UpVector = Character->GetActorUpVector();
+	MaxSpeed = Movement->GetMaxSpeed();
+	bIsClimbing = Movement->IsClimbing();
+	bIsHanging = Movement->IsHanging();
+	bIsVaulting = Movement->IsVaulting();
+	bIsFalling = Movement->IsFalling();
+
+	if (bIsClimbing)
+	{
+		UpdateLimbTraces(*CastChecked<UClimbingAnimInstance>(InAnimInstance), *Character, *Movement);
+	}
+	else
+	{
+		LimbTraces.Reset();
+	}
+
+	for (int32 Index = 0; Index < FClimbingLimbTraces::NumLimbs; ++Index)
+	{
+		LimbContacts[Index] = LimbTraces.GetContact(static_cast<EClimbingLimb>(Index));
+	}
+}
+
+void FClimbingAnimInstanceProxy::UpdateLimbTraces(UClimbingAnimInstance& Instance, const ACharacter& Character, const UClimbingMovementComponent& Movement)
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingLimbTraces);
+
+	UWorld* World = Character.GetWorld();
+	const USkeletalMeshComponent* Mesh = Instance.GetSkelMeshComponent();
+	if (!World || !Mesh || World->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	LimbTraces.Consume(World);
+
+	// The local player is always traced, the other climbers at a rate that depends on how big they are on screen
+	int32 Interval = 1;
+	if (!Character.IsLocallyControlled() || !Character.IsPlayerControlled())
+	{
+		Interval = 0;
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		if (PlayerController && PlayerController->PlayerCameraManager && Mesh->WasRecentlyRendered(0.2f))
+		{
+			const APlayerCameraManager* Camera = PlayerController->PlayerCameraManager;
+			const float Distance = FVector::Dist(Camera->GetCameraLocation(), Mesh->Bounds.Origin);
+			const float ScreenSize = ClimbingLimbIK::GetScreenSize(Mesh->Bounds.SphereRadius, Distance, Camera->GetFOVAngle());
+			Interval = ClimbingLimbIK::GetTraceInterval(ScreenSize, Instance.LimbTraceFullRateScreenSize,
+			                                            Instance.LimbTraceMinScreenSize, Instance.LimbTraceMaxInterval);
+		}
+	}
+
+	// Climbers at the same rate are spread over the frames
+	if (Interval == 0 || (GFrameCounter + Character.GetUniqueID()) % Interval != 0)
+	{
+		return;
+	}
+
+	const FName Bones[FClimbingLimbTraces::NumLimbs] = {Instance.HandLeftBone, Instance.HandRightBone, Instance.FootLeftBone, Instance.FootRightBone};
+	const FVector WallDirection = Character.GetActorForwardVector();
+	for (int32 Index = 0; Index < FClimbingLimbTraces::NumLimbs; ++Index)
+	{
+		if (Mesh->GetBoneIndex(Bones[Index]) == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FVector BoneLocation = Mesh->GetSocketLocation(Bones[Index]);
+		LimbTraces.AddTrace(static_cast<EClimbingLimb>(Index), BoneLocation - WallDirection * Instance.LimbTraceBack,
+		                    BoneLocation + WallDirection * Instance.LimbTraceReach);
+	}
+
+	const int32 NumTraces = LimbTraces.Submit(World, Mesh->GetComponentTransform(), ECC_Climbable,
+	                                          FCollisionQueryParams(SCENE_QUERY_STAT(ClimbingLimbTrace), false, &Character));
+	CLIMBING_COUNT_SWEEPS(NumTraces);
+}
+
+void FClimbingAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	// Runs before the anim graph update, on the thread that evaluates it
+	UClimbingAnimInstance* Instance = CastChecked<UClimbingAnimInstance>(GetAnimInstanceObject());
+
+	const FVector2D WallVelocity(FVector::DotProduct(Velocity, RightVector), FVector::DotProduct(Velocity, UpVector));
+	Instance->Speed = Velocity.Size();
+	Instance->ClimbVelocity = MaxSpeed > 0.f ? WallVelocity / MaxSpeed : FVector2D::ZeroVector;
+	Instance->ClimbInput = FVector2D(FVector::DotProduct(Acceleration, RightVector), FVector::DotProduct(Acceleration, UpVector)).GetSafeNormal();
+	Instance->bIsClimbing = bIsClimbing;
+	Instance->bIsHanging = bIsHanging;
+	Instance->bIsVaulting = bIsVaulting;
+	Instance->bIsFalling = bIsFalling;
+
+	// Each direction of movement on the wall gets its share, the rest is the idle hang
+	float UpTarget = 0.f, DownTarget = 0.f, LeftTarget = 0.f, RightTarget = 0.f, IdleTarget = 0.f;
+	if (bIsClimbing || bIsHanging)
+	{
+		const FVector2D Direction = Instance->ClimbVelocity.ClampAxes(-1.f, 1.f);
+		const float MoveWeight = FMath::Min(FMath::Abs(Direction.X) + FMath::Abs(Direction.Y), 1.f);
+		const float AxisSum = FMath::Max(FMath::Abs(Direction.X) + FMath::Abs(Direction.Y), KINDA_SMALL_NUMBER);
+
+		UpTarget = MoveWeight * FMath::Max(Direction.Y, 0.f) / AxisSum;
+		DownTarget = MoveWeight * FMath::Max(-Direction.Y, 0.f) / AxisSum;
+		RightTarget = MoveWeight * FMath::Max(Direction.X, 0.f) / AxisSum;
+		LeftTarget = MoveWeight * FMath::Max(-Direction.X, 0.f) / AxisSum;
+		IdleTarget = 1.f - MoveWeight;
+	}
+
+	const float BlendSpeed = Instance->ClimbBlendSpeed;
+	Instance->ClimbUpWeight = FMath::FInterpTo(Instance->ClimbUpWeight, UpTarget, DeltaSeconds, BlendSpeed);
+	Instance->ClimbDownWeight = FMath::FInterpTo(Instance->ClimbDownWeight, DownTarget, DeltaSeconds, BlendSpeed);
+	Instance->ShimmyRightWeight = FMath::FInterpTo(Instance->ShimmyRightWeight, RightTarget, DeltaSeconds, BlendSpeed);
+	Instance->ShimmyLeftWeight = FMath::FInterpTo(Instance->ShimmyLeftWeight, LeftTarget, DeltaSeconds, BlendSpeed);
+	Instance->HangIdleWeight = FMath::FInterpTo(Instance->HangIdleWeight, IdleTarget, DeltaSeconds, BlendSpeed);
+
+	UpdateLimbIK(*Instance, DeltaSeconds);
+}
+
+void FClimbingAnimInstanceProxy::UpdateLimbIK(UClimbingAnimInstance& Instance, float DeltaSeconds)
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingLimbIK);
+
+	for (int32 Index = 0; Index < FClimbingLimbTraces::NumLimbs; ++Index)
+	{
+		const FClimbingLimbContact& Contact = LimbContacts[Index];
+		const bool bPlaced = bIsClimbing && !bIsVaulting && Contact.bHit;
+
+		if (bPlaced)
+		{
+			// A limb that was not placed starts right on its contact, its alpha does the blend in
+			const FVector Target = Contact.Location + Contact.Normal * Instance.LimbContactOffset;
+			LimbEffectors[Index] = LimbAlphas[Index] > 0.f
+				? FMath::VInterpTo(LimbEffectors[Index], Target, DeltaSeconds, Instance.LimbIKInterpSpeed)
+				: Target;
+		}
+		LimbAlphas[Index] = FMath::FInterpTo(LimbAlphas[Index], bPlaced ? 1.f : 0.f, DeltaSeconds, Instance.LimbIKInterpSpeed);
+		if (LimbAlphas[Index] < KINDA_SMALL_NUMBER)
+		{
+			LimbAlphas[Index] = 0.f;
+		}
+	}
+
+	Instance.HandLeftEffector = LimbEffectors[static_cast<int32>(EClimbingLimb::HandLeft)];
+	Instance.HandRightEffector = LimbEffectors[static_cast<int32>(EClimbingLimb::HandRight)];
+	Instance.FootLeftEffector = LimbEffectors[static_cast<int32>(EClimbingLimb::FootLeft)];
+	Instance.FootRightEffector = LimbEffectors[static_cast<int32>(EClimbingLimb::FootRight)];
+	Instance.HandLeftAlpha = LimbAlphas[static_cast<int32>(EClimbingLimb::HandLeft)];
+	Instance.HandRightAlpha = LimbAlphas[static_cast<int32>(EClimbingLimb::HandRight)];
+	Instance.FootLeftAlpha = LimbAlphas[static_cast<int32>(EClimbingLimb::FootLeft)];
+	Instance.FootRightAlpha = LimbAlphas[static_cast<int32>(EClimbingLimb::FootRight)];
+}
+
+FAnimInstanceProxy* UClimbingAnimInstance::CreateAnimInstanceProxy()
+{
+	return &Proxy;
+}
+
+void UClimbingAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	// The proxy is a member, nothing to free
+}
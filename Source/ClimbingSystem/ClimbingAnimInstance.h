@@ -0,0 +1,194 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "ClimbingLimbIK.h"
+#include "ClimbingAnimInstance.generated.h"
+
+class ACharacter;
+class UClimbingAnimInstance;
+class UClimbingMovementComponent;
+
+/** Copies the climbing state of the character once per tick, the blend logic then runs on the animation worker thread */
+USTRUCT()
+struct FClimbingAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FClimbingAnimInstanceProxy()
+	{
+	}
+
+	FClimbingAnimInstanceProxy(UAnimInstance* InAnimInstance)
+		: FAnimInstanceProxy(InAnimInstance)
+	{
+	}
+
+	//Begin FAnimInstanceProxy Interface
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+	//End FAnimInstanceProxy Interface
+
+private:
+	/** Consumes the limb traces of last frame and submits new ones, at a rate that depends on the screen size of the climber */
+	void UpdateLimbTraces(UClimbingAnimInstance& Instance, const ACharacter& Character, const UClimbingMovementComponent& Movement);
+
+	/** Moves the IK effectors towards the contacts of the limbs */
+	void UpdateLimbIK(UClimbingAnimInstance& Instance, float DeltaSeconds);
+
+	FClimbingLimbTraces LimbTraces;
+
+	/** Contacts of the limbs, copied from LimbTraces in PreUpdate */
+	FClimbingLimbContact LimbContacts[FClimbingLimbTraces::NumLimbs];
+
+	/** Effectors in component space and IK alphas, blended towards the contacts */
+	FVector LimbEffectors[FClimbingLimbTraces::NumLimbs];
+	float LimbAlphas[FClimbingLimbTraces::NumLimbs] = {};
+
+	/** Game thread state, copied in PreUpdate */
+	FVector Velocity = FVector::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+	FVector RightVector = FVector::RightVector;
+	FVector UpVector = FVector::UpVector;
+	float MaxSpeed = 0.f;
+	bool bIsClimbing = false;
+	bool bIsHanging = false;
+	bool bIsVaulting = false;
+	bool bIsFalling = false;
+};
+
+/**
+ * Anim instance of the climbing character. The variables read by the anim graph are computed by
+ * FClimbingAnimInstanceProxy, off the game thread when multi threaded animation update is enabled,
+ * so the graph should only read them and have no update event of its own.
+ */
+UCLASS(Transient, Blueprintable)
+class UClimbingAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	/** Speed of the character */
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	float Speed = 0.f;
+
+	/** Velocity on the wall, as a fraction of the max speed. X is right and Y up */
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	FVector2D ClimbVelocity = FVector2D::ZeroVector;
+
+	/** Input on the wall plane, X is right and Y up */
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	FVector2D ClimbInput = FVector2D::ZeroVector;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	bool bIsClimbing = false;
+
+	/** Hanging from a ledge, the left and right weights are the braced shimmy */
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	bool bIsHanging = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	bool bIsVaulting = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	bool bIsFalling = false;
+
+	/** Blend weights of the climbing animations, they add up to one while climbing */
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	float ClimbUpWeight = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	float ClimbDownWeight = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	float ShimmyLeftWeight = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	float ShimmyRightWeight = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category=Climbing)
+	float HangIdleWeight = 0.f;
+
+	/** IK effectors of the limbs on the wall, in component space, and how much of the IK to apply.
+	 *  Meant for Two Bone IK nodes with the effector location space set to Component Space */
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	FVector HandLeftEffector = FVector::ZeroVector;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	FVector HandRightEffector = FVector::ZeroVector;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	FVector FootLeftEffector = FVector::ZeroVector;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	FVector FootRightEffector = FVector::ZeroVector;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	float HandLeftAlpha = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	float HandRightAlpha = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	float FootLeftAlpha = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category="Climbing|Limb IK")
+	float FootRightAlpha = 0.f;
+
+	/** Bones traced towards the wall to place the limbs */
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK")
+	FName HandLeftBone = TEXT("hand_l");
+
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK")
+	FName HandRightBone = TEXT("hand_r");
+
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK")
+	FName FootLeftBone = TEXT("foot_l");
+
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK")
+	FName FootRightBone = TEXT("foot_r");
+
+	/** Length of the limb traces in front of the animated bones, and how far behind them they start */
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK", meta=(ClampMin="0", UIMin="0"))
+	float LimbTraceReach = 40.f;
+
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK", meta=(ClampMin="0", UIMin="0"))
+	float LimbTraceBack = 20.f;
+
+	/** Distance of the effectors from the wall, the thickness of the hands and feet */
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK", meta=(ClampMin="0", UIMin="0"))
+	float LimbContactOffset = 5.f;
+
+	/** How fast the effectors and the alphas follow the contacts */
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK", meta=(ClampMin="0", UIMin="0"))
+	float LimbIKInterpSpeed = 15.f;
+
+	/** Screen size at and above which the limbs are traced every frame. Locally controlled climbers always are */
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK", meta=(ClampMin="0", UIMin="0"))
+	float LimbTraceFullRateScreenSize = 0.5f;
+
+	/** Below this screen size the contacts are frozen and no trace is issued */
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK", meta=(ClampMin="0", UIMin="0"))
+	float LimbTraceMinScreenSize = 0.05f;
+
+	/** Frames between two traces of a climber, just above LimbTraceMinScreenSize */
+	UPROPERTY(EditDefaultsOnly, Category="Climbing|Limb IK", meta=(ClampMin="1", UIMin="1"))
+	int32 LimbTraceMaxInterval = 4;
+
+	/** How fast the blend weights follow the movement */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Climbing, meta=(ClampMin="0", UIMin="0"))
+	float ClimbBlendSpeed = 10.f;
+
+protected:
+	//Begin UAnimInstance Interface
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+	//End UAnimInstance Interface
+
+private:
+	UPROPERTY(Transient)
+	FClimbingAnimInstanceProxy Proxy;
+};
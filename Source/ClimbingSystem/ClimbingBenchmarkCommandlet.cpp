@@ -0,0 +1,468 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingBenchmarkCommandlet.h"
+
+#include "ClimbingMovementComponent.h"
+#include "ClimbingStats.h"
+#include "ClimbingSystem.h"
+#include "ClimbingSystemCharacter.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Landscape.h"
+#include "LandscapeDataAccess.h"
+#include "LandscapeInfo.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace ClimbingBenchmark
+{
+	/** Spawns a box whose face, centered on FacePoint, looks towards FaceNormal */
+	static AStaticMeshActor* SpawnWall(UWorld* World, UStaticMesh* Cube, const FVector& FacePoint, const FVector& FaceNormal,
+	                                   float Width, float Height, float Thickness = 50.f)
+	{
+		const FVector Normal = FaceNormal.GetSafeNormal();
+		const FTransform Transform((-Normal).Rotation(), FacePoint - Normal * Thickness * 0.5f);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AStaticMeshActor* Wall = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform, SpawnParams);
+
+		// The mesh of a static component can't be changed once registered
+		UStaticMeshComponent* MeshComponent = Wall->GetStaticMeshComponent();
+		MeshComponent->SetMobility(EComponentMobility::Movable);
+		MeshComponent->SetStaticMesh(Cube);
+		MeshComponent->SetWorldScale3D(FVector(Thickness, Width, Height) / 100.f);
+		MeshComponent->SetMobility(EComponentMobility::Static);
+		return Wall;
+	}
+
+	static void SpawnFloor(UWorld* World, UStaticMesh* Cube)
+	{
+		SpawnWall(World, Cube, FVector::ZeroVector, FVector::UpVector, 10000.f, 10000.f);
+	}
+
+	/**
+	 * Spawns a landscape of a single component: flat ground under the climbers, then a cliff of irregular slope
+	 * rising from X = 150 up to a plateau. Its probes go through the heightfield collision and the landscape sampler.
+	 * Landscapes are built with editor code, the scenario is empty in other builds
+	 */
+	static void SpawnLandscapeCliff(UWorld* World)
+	{
+#if WITH_EDITOR
+		const int32 SizeQuads = 63;
+		const int32 SizeVerts = SizeQuads + 1;
+		const FVector Scale(50.f, 50.f, 100.f);
+		const FVector Origin(-600.f, -0.5f * SizeQuads * Scale.Y, 0.f);
+		const float CliffHeight = 2500.f;
+
+		TArray<uint16> Heights;
+		Heights.SetNumUninitialized(SizeVerts * SizeVerts);
+		for (int32 Y = 0; Y < SizeVerts; ++Y)
+		{
+			for (int32 X = 0; X < SizeVerts; ++X)
+			{
+				const FVector2D Location = FVector2D(Origin) + FVector2D(X * Scale.X, Y * Scale.Y);
+
+				// The foot of the cliff wanders along it, and its slope goes from 60 to 80 degrees
+				const float Foot = 150.f + 40.f * FMath::Sin(Location.Y / 300.f);
+				const float Slope = FMath::Tan(FMath::DegreesToRadians(70.f + 10.f * FMath::Sin(Location.Y / 450.f)));
+				float Height = FMath::Clamp((Location.X - Foot) * Slope, 0.f, CliffHeight);
+
+				// Bumps on the face only, the ground and the plateau stay flat
+				if (Height > 0.f && Height < CliffHeight)
+				{
+					Height += 30.f * FMath::Sin(Location.X / 70.f) * FMath::Cos(Location.Y / 90.f);
+				}
+				Heights[Y * SizeVerts + X] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(LandscapeDataAccess::MidValue + Height / (Scale.Z * LANDSCAPE_ZSCALE)), 0, MAX_uint16));
+			}
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ALandscape* Landscape = World->SpawnActor<ALandscape>(ALandscape::StaticClass(), FTransform(FQuat::Identity, Origin, Scale), SpawnParams);
+		Landscape->bCanHaveLayersContent = false;
+
+		TMap<FGuid, TArray<uint16>> HeightData;
+		HeightData.Add(FGuid(), MoveTemp(Heights));
+		TMap<FGuid, TArray<FLandscapeImportLayerInfo>> LayerInfos;
+		LayerInfos.Add(FGuid());
+		Landscape->Import(FGuid::NewGuid(), 0, 0, SizeQuads, SizeQuads, 1, SizeQuads, HeightData, nullptr, LayerInfos, ELandscapeImportAlphamapType::Additive);
+		Landscape->GetLandscapeInfo()->UpdateLayerInfoMap(Landscape);
+#else
+		UE_LOG(LogClimbing, Warning, TEXT("Climbing benchmark: landscapes can only be built in editor builds"));
+#endif
+	}
+
+	/** Normal of a wall facing the climber, tilted by ClimbAngle like the pitch checked against MaxClimbAngle */
+	static FVector MakeWallNormal(float ClimbAngle)
+	{
+		const float Radians = FMath::DegreesToRadians(ClimbAngle);
+		return FVector(-FMath::Cos(Radians), 0.f, -FMath::Sin(Radians));
+	}
+
+	/** Index of a percentile in sorted samples */
+	static int32 PercentileIndex(int32 NumSamples, float Percentile)
+	{
+		return FMath::Clamp(FMath::CeilToInt(Percentile * NumSamples) - 1, 0, NumSamples - 1);
+	}
+}
+
+UClimbingBenchmarkCommandlet::UClimbingBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	DeltaTime = 1.f / 60.f;
+	MinTraversalDistance = 100.f;
+}
+
+int32 UClimbingBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("ClimbingBenchmark.json");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	int32 NumRuns = 8;
+	FParse::Value(*Params, TEXT("Runs="), NumRuns);
+	NumRuns = FMath::Max(NumRuns, 1);
+
+	FString ScenarioFilter;
+	FParse::Value(*Params, TEXT("Scenario="), ScenarioFilter);
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!Cube)
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing benchmark: can't load the cube mesh to build the test levels"));
+		return 1;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ScenarioReports;
+	for (const FClimbingBenchmarkScenario& Scenario : MakeScenarios())
+	{
+		if (!ScenarioFilter.IsEmpty() && Scenario.Name != ScenarioFilter)
+		{
+			continue;
+		}
+
+		FClimbingBenchmarkResult Result = RunScenario(Scenario, NumRuns, Cube);
+
+		TArray<double> SortedTimes = Result.ClimbingTimes;
+		SortedTimes.Sort();
+		double TotalTime = 0.0;
+		for (const double Time : SortedTimes)
+		{
+			TotalTime += Time;
+		}
+
+		uint32 TotalQueries = 0;
+		uint32 MaxQueries = 0;
+		for (const uint32 Queries : Result.SceneQueries)
+		{
+			TotalQueries += Queries;
+			MaxQueries = FMath::Max(MaxQueries, Queries);
+		}
+
+		const int32 NumTicks = SortedTimes.Num();
+		const uint32 CacheProbes = Result.SurfaceCacheHits + Result.SurfaceCacheMisses;
+
+		TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetStringField(TEXT("name"), Scenario.Name);
+		Report->SetNumberField(TEXT("runs"), Result.NumRuns);
+		Report->SetNumberField(TEXT("ticks"), NumTicks);
+		Report->SetNumberField(TEXT("climbing_time_us_mean"), NumTicks > 0 ? TotalTime / NumTicks : 0.0);
+		Report->SetNumberField(TEXT("climbing_time_us_p99"), NumTicks > 0 ? SortedTimes[ClimbingBenchmark::PercentileIndex(NumTicks, 0.99f)] : 0.0);
+		Report->SetNumberField(TEXT("scene_queries_per_tick_mean"), NumTicks > 0 ? static_cast<double>(TotalQueries) / NumTicks : 0.0);
+		Report->SetNumberField(TEXT("scene_queries_per_tick_max"), MaxQueries);
+		Report->SetNumberField(TEXT("landscape_samples_per_tick_mean"), NumTicks > 0 ? static_cast<double>(Result.LandscapeSamples) / NumTicks : 0.0);
+		Report->SetNumberField(TEXT("attach_rate"), static_cast<double>(Result.NumAttached) / Result.NumRuns);
+		Report->SetNumberField(TEXT("traversal_rate"), static_cast<double>(Result.NumTraversed) / Result.NumRuns);
+		if (Scenario.VaultHeight > 0.f)
+		{
+			Report->SetNumberField(TEXT("vault_rate"), static_cast<double>(Result.NumVaulted) / Result.NumRuns);
+		}
+		Report->SetNumberField(TEXT("surface_cache_hit_rate"), CacheProbes > 0 ? static_cast<double>(Result.SurfaceCacheHits) / CacheProbes : 0.0);
+		ScenarioReports.Add(MakeShared<FJsonValueObject>(Report));
+
+		UE_LOG(LogClimbing, Display, TEXT("Climbing benchmark %s: %.2f us mean, %.2f us p99, %.2f queries per tick"),
+		       *Scenario.Name, Report->GetNumberField(TEXT("climbing_time_us_mean")),
+		       Report->GetNumberField(TEXT("climbing_time_us_p99")), Report->GetNumberField(TEXT("scene_queries_per_tick_mean")));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("delta_time"), DeltaTime);
+	Root->SetNumberField(TEXT("runs_per_scenario"), NumRuns);
+	Root->SetArrayField(TEXT("scenarios"), ScenarioReports);
+
+	FString Output;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	if (!FFileHelper::SaveStringToFile(Output, *ReportPath))
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing benchmark: can't write the report to %s"), *ReportPath);
+		return 1;
+	}
+
+	UE_LOG(LogClimbing, Display, TEXT("Climbing benchmark report written to %s"), *ReportPath);
+	return 0;
+}
+
+FClimbingBenchmarkResult UClimbingBenchmarkCommandlet::RunScenario(const FClimbingBenchmarkScenario& Scenario, int32 NumRuns, UStaticMesh* Cube)
+{
+	FClimbingBenchmarkResult Result;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, FName(*FString::Printf(TEXT("ClimbingBenchmark_%s"), *Scenario.Name)));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	Scenario.BuildLevel(World, Cube);
+	FApp::SetDeltaTime(DeltaTime);
+
+	for (int32 Run = 0; Run < NumRuns; ++Run)
+	{
+		// Each run starts a bit to the side of the previous one
+		const FVector SpawnLocation(0.f, Run * 15.f, 100.f);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		AClimbingSystemCharacter* Character =
+			World->SpawnActor<AClimbingSystemCharacter>(AClimbingSystemCharacter::StaticClass(), SpawnLocation, FRotator::ZeroRotator, SpawnParams);
+		if (!Character)
+		{
+			continue;
+		}
+		Character->SpawnDefaultController();
+
+		bool bAttached = false;
+		float TraversedDistance = 0.f;
+		FVector LastLocation = Character->GetActorLocation();
+
+		for (int32 Frame = 0; Frame < Scenario.NumFrames; ++Frame)
+		{
+			const FClimbingBenchmarkInput Input = Scenario.Input(Frame);
+			FClimbingFrameCounters::Get().Reset();
+
+			ApplyInput(Character, Input);
+			World->Tick(LEVELTICK_All, DeltaTime);
+			++GFrameCounter;
+
+			const FClimbingFrameCounters& Counters = FClimbingFrameCounters::Get();
+			Result.ClimbingTimes.Add(FPlatformTime::ToMilliseconds64(Counters.Cycles) * 1000.0);
+			Result.SceneQueries.Add(Counters.SceneQueries);
+			Result.LandscapeSamples += Counters.LandscapeSamples;
+
+			const FVector Location = Character->GetActorLocation();
+			if (Character->GetClimbingMovement()->IsClimbing())
+			{
+				bAttached = true;
+
+				// Only the movement driven by input counts, not the move to the wall on attach
+				if (Input.Forward != 0.f || Input.Right != 0.f)
+				{
+					TraversedDistance += FVector::Dist(Location, LastLocation);
+				}
+			}
+			LastLocation = Location;
+		}
+
+		const UClimbingMovementComponent* Movement = Character->GetClimbingMovement();
+		++Result.NumRuns;
+		Result.NumAttached += bAttached ? 1 : 0;
+		Result.NumTraversed += TraversedDistance >= MinTraversalDistance ? 1 : 0;
+		if (Scenario.VaultHeight > 0.f && !Movement->IsClimbing() && Movement->GetActorFeetLocation().Z >= Scenario.VaultHeight - 1.f)
+		{
+			++Result.NumVaulted;
+		}
+		Result.SurfaceCacheHits += Movement->GetSurfaceCache().GetHitCount();
+		Result.SurfaceCacheMisses += Movement->GetSurfaceCache().GetMissCount();
+
+		if (AController* Controller = Character->GetController())
+		{
+			Controller->Destroy();
+		}
+		Character->Destroy();
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return Result;
+}
+
+void UClimbingBenchmarkCommandlet::ApplyInput(AClimbingSystemCharacter* Character, const FClimbingBenchmarkInput& Input) const
+{
+	if (Input.bGrab)
+	{
+		Character->HandleWallGrab();
+	}
+	if (Input.bJump)
+	{
+		Character->JumpStart();
+	}
+	Character->MoveForward(Input.Forward);
+	Character->MoveRight(Input.Right);
+}
+
+TArray<FClimbingBenchmarkScenario> UClimbingBenchmarkCommandlet::MakeScenarios() const
+{
+	using namespace ClimbingBenchmark;
+	TArray<FClimbingBenchmarkScenario> Scenarios;
+
+	// Climbers spawn at the origin facing +X, walls are placed in front of them.
+	// They grab on the first frame and start moving once the attach movement is over
+	const int32 MoveStart = 20;
+
+	{
+		FClimbingBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+		Scenario.Name = TEXT("FlatWall");
+		Scenario.NumFrames = 340;
+		Scenario.BuildLevel = [](UWorld* World, UStaticMesh* Cube)
+		{
+			SpawnFloor(World, Cube);
+			SpawnWall(World, Cube, FVector(150.f, 0.f, 1500.f), MakeWallNormal(0.f), 3000.f, 3000.f);
+		};
+		Scenario.Input = [MoveStart](int32 Frame)
+		{
+			FClimbingBenchmarkInput Input;
+			Input.bGrab = Frame == 0;
+			Input.Forward = Frame >= MoveStart && Frame < 140 ? 1.f : 0.f;
+			Input.Right = Frame >= 140 && Frame < 260 ? 1.f : 0.f;
+			// Jump up the wall, the climber reattaches at the apex
+			Input.bJump = Frame == 270;
+			return Input;
+		};
+	}
+
+	{
+		FClimbingBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+		Scenario.Name = TEXT("InsideCorner");
+		Scenario.BuildLevel = [](UWorld* World, UStaticMesh* Cube)
+		{
+			SpawnFloor(World, Cube);
+			SpawnWall(World, Cube, FVector(150.f, 0.f, 1500.f), MakeWallNormal(0.f), 3000.f, 3000.f);
+			SpawnWall(World, Cube, FVector(-600.f, 250.f, 1500.f), FVector(0.f, -1.f, 0.f), 1500.f, 3000.f);
+		};
+		Scenario.Input = [MoveStart](int32 Frame)
+		{
+			FClimbingBenchmarkInput Input;
+			Input.bGrab = Frame == 0;
+			Input.Forward = Frame >= MoveStart && Frame < 60 ? 1.f : 0.f;
+			Input.Right = Frame >= 60 ? 1.f : 0.f;
+			return Input;
+		};
+	}
+
+	{
+		FClimbingBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+		Scenario.Name = TEXT("OutsideCorner");
+		Scenario.BuildLevel = [](UWorld* World, UStaticMesh* Cube)
+		{
+			SpawnFloor(World, Cube);
+			SpawnWall(World, Cube, FVector(150.f, -625.f, 1500.f), MakeWallNormal(0.f), 1750.f, 3000.f, 1000.f);
+		};
+		Scenario.Input = [MoveStart](int32 Frame)
+		{
+			FClimbingBenchmarkInput Input;
+			Input.bGrab = Frame == 0;
+			Input.Forward = Frame >= MoveStart && Frame < 60 ? 1.f : 0.f;
+			Input.Right = Frame >= 60 ? 1.f : 0.f;
+			return Input;
+		};
+	}
+
+	{
+		// Leaning over the climber past MaxClimbAngle, climbing up has to be refused
+		FClimbingBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+		Scenario.Name = TEXT("Overhang");
+		Scenario.BuildLevel = [](UWorld* World, UStaticMesh* Cube)
+		{
+			SpawnFloor(World, Cube);
+			SpawnWall(World, Cube, FVector(150.f, 0.f, 100.f), MakeWallNormal(60.f), 3000.f, 3000.f);
+		};
+		Scenario.Input = [MoveStart](int32 Frame)
+		{
+			FClimbingBenchmarkInput Input;
+			Input.bGrab = Frame == 0;
+			Input.Forward = Frame >= MoveStart ? 1.f : 0.f;
+			return Input;
+		};
+	}
+
+	{
+		// Panels with random slopes stacked on top of each other, a wall of changing angles made of meshes
+		FClimbingBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+		Scenario.Name = TEXT("SlopedPanels");
+		Scenario.NumFrames = 360;
+		Scenario.BuildLevel = [](UWorld* World, UStaticMesh* Cube)
+		{
+			SpawnFloor(World, Cube);
+			FRandomStream Stream(1234);
+			for (int32 Panel = 0; Panel < 12; ++Panel)
+			{
+				const float ClimbAngle = Stream.FRandRange(-30.f, 30.f);
+				const FVector FacePoint(150.f + Stream.FRandRange(-10.f, 10.f), 0.f, 100.f + Panel * 180.f);
+				SpawnWall(World, Cube, FacePoint, MakeWallNormal(ClimbAngle), 3000.f, 240.f);
+			}
+		};
+		Scenario.Input = [MoveStart](int32 Frame)
+		{
+			FClimbingBenchmarkInput Input;
+			Input.bGrab = Frame == 0;
+			Input.Forward = Frame >= MoveStart ? 1.f : 0.f;
+			Input.Right = Frame >= MoveStart ? FMath::Sin(Frame * 0.05f) : 0.f;
+			return Input;
+		};
+	}
+
+	{
+		// A landscape cliff, answered from the collision heights once the climber is on it
+		FClimbingBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+		Scenario.Name = TEXT("LandscapeCliff");
+		Scenario.NumFrames = 360;
+		Scenario.BuildLevel = [](UWorld* World, UStaticMesh*)
+		{
+			SpawnLandscapeCliff(World);
+		};
+		Scenario.Input = [MoveStart](int32 Frame)
+		{
+			FClimbingBenchmarkInput Input;
+			Input.bGrab = Frame == 0;
+			Input.Forward = Frame >= MoveStart ? 1.f : 0.f;
+			Input.Right = Frame >= MoveStart ? FMath::Sin(Frame * 0.05f) : 0.f;
+			return Input;
+		};
+	}
+
+	{
+		// A 3 meters wall with a platform on top to vault on
+		FClimbingBenchmarkScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+		Scenario.Name = TEXT("Ledge");
+		Scenario.VaultHeight = 300.f;
+		Scenario.BuildLevel = [](UWorld* World, UStaticMesh* Cube)
+		{
+			SpawnFloor(World, Cube);
+			SpawnWall(World, Cube, FVector(150.f, 0.f, 150.f), MakeWallNormal(0.f), 3000.f, 300.f, 800.f);
+		};
+		Scenario.Input = [MoveStart](int32 Frame)
+		{
+			FClimbingBenchmarkInput Input;
+			Input.bGrab = Frame == 0;
+			Input.Forward = Frame >= MoveStart && Frame < 200 ? 1.f : 0.f;
+			return Input;
+		};
+	}
+
+	return Scenarios;
+}
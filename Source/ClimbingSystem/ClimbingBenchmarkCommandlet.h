@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbingBenchmarkCommandlet.generated.h"
+
+class AClimbingSystemCharacter;
+class UStaticMesh;
+
+/** Input given to a climber on a frame of a scenario */
+struct FClimbingBenchmarkInput
+{
+	float Forward = 0.f;
+	float Right = 0.f;
+	bool bGrab = false;
+	bool bJump = false;
+};
+
+/** A test level and the input its climbers follow */
+struct FClimbingBenchmarkScenario
+{
+	FString Name;
+
+	/** Spawns the geometry of the level */
+	TFunction<void(UWorld*, UStaticMesh*)> BuildLevel;
+
+	/** Input of a climber for a frame */
+	TFunction<FClimbingBenchmarkInput(int32 Frame)> Input;
+
+	/** Frames each climber is simulated for */
+	int32 NumFrames = 300;
+
+	/** Height the climber has to end above for the vault to be successful, zero if the scenario has no ledge */
+	float VaultHeight = 0.f;
+};
+
+/** Samples and outcomes gathered by a scenario */
+struct FClimbingBenchmarkResult
+{
+	TArray<double> ClimbingTimes;
+	TArray<uint32> SceneQueries;
+	int32 NumRuns = 0;
+	int32 NumAttached = 0;
+	int32 NumTraversed = 0;
+	int32 NumVaulted = 0;
+	uint32 SurfaceCacheHits = 0;
+	uint32 SurfaceCacheMisses = 0;
+	uint32 LandscapeSamples = 0;
+};
+
+/**
+ * Headless benchmark of the climbing system. For each scenario it generates a test level, spawns
+ * climbers that follow scripted input and writes a JSON report that can be diffed between builds.
+ *
+ * UE4Editor-Cmd ClimbingSystem.uproject -run=ClimbingBenchmark -nullrhi -unattended
+ *     [-Report=<path>] [-Runs=<runs per scenario>] [-Scenario=<name>]
+ */
+UCLASS()
+class UClimbingBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingBenchmarkCommandlet();
+
+	//Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//End UCommandlet Interface
+
+private:
+	/** Simulates every run of a scenario in a fresh world */
+	FClimbingBenchmarkResult RunScenario(const FClimbingBenchmarkScenario& Scenario, int32 NumRuns, UStaticMesh* Cube);
+
+	/** Scripted input is fed to a climber the same way player input is */
+	void ApplyInput(AClimbingSystemCharacter* Character, const FClimbingBenchmarkInput& Input) const;
+
+	TArray<FClimbingBenchmarkScenario> MakeScenarios() const;
+
+	/** Fixed time step of the simulation */
+	float DeltaTime;
+
+	/** Distance a climber has to cover on the wall for the traversal to be successful */
+	float MinTraversalDistance;
+};
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingDebug.h"
+
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
+
+namespace ClimbingDebug
+{
+#if ENABLE_DRAW_DEBUG
+	static int32 DebugDraw = 0;
+	static FAutoConsoleVariableRef CVarDebugDraw(
+		TEXT("climbing.DebugDraw"),
+		DebugDraw,
+		TEXT("Draws the probes of the climbing system. 0: off, 1: on"),
+		ECVF_Cheat);
+#endif
+
+	static float LogInterval = 1.f;
+	static FAutoConsoleVariableRef CVarLogInterval(
+		TEXT("climbing.LogInterval"),
+		LogInterval,
+		TEXT("Minimum time in seconds between two lines logged by the same climbing call site"),
+		ECVF_Default);
+
+#if ENABLE_DRAW_DEBUG
+	bool IsDrawEnabled()
+	{
+		return DebugDraw > 0;
+	}
+
+	void DrawProbe(const UWorld* World, const FVector& Start, const FVector& End, const FColor& Color)
+	{
+		if (IsDrawEnabled())
+		{
+			DrawDebugLine(World, Start, End, Color, false, 0.3f, 0, 2.f);
+		}
+	}
+
+	void DrawCapsule(const UWorld* World, const FVector& Center, float HalfHeight, float Radius, const FColor& Color)
+	{
+		if (IsDrawEnabled())
+		{
+			DrawDebugCapsule(World, Center, HalfHeight, Radius, FQuat::Identity, Color, false, 2.f, 3, 1.f);
+		}
+	}
+#endif
+
+	bool ShouldLog(double& LastLogTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastLogTime < LogInterval)
+		{
+			return false;
+		}
+		LastLogTime = Now;
+		return true;
+	}
+}
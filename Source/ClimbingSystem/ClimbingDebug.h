@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingSystem.h"
+
+class UWorld;
+
+namespace ClimbingDebug
+{
+#if ENABLE_DRAW_DEBUG
+	/** Is the climbing debug drawing enabled with climbing.DebugDraw? */
+	bool IsDrawEnabled();
+
+	void DrawProbe(const UWorld* World, const FVector& Start, const FVector& End, const FColor& Color);
+	void DrawCapsule(const UWorld* World, const FVector& Center, float HalfHeight, float Radius, const FColor& Color);
+#else
+	inline bool IsDrawEnabled() { return false; }
+
+	inline void DrawProbe(const UWorld* World, const FVector& Start, const FVector& End, const FColor& Color) {}
+	inline void DrawCapsule(const UWorld* World, const FVector& Center, float HalfHeight, float Radius, const FColor& Color) {}
+#endif
+
+	/** Returns true if a log line throttled by LastLogTime can be written, and updates it.
+	 *  Lines are written at most once every climbing.LogInterval seconds */
+	bool ShouldLog(double& LastLogTime);
+}
+
+/** Logs to LogClimbing, at most once every climbing.LogInterval seconds for each call site */
+#define UE_LOG_CLIMBING_THROTTLED(Verbosity, Format, ...) \
+	do \
+	{ \
+		static double LastClimbingLogTime = -DBL_MAX; \
+		if (UE_LOG_ACTIVE(LogClimbing, Verbosity) && ClimbingDebug::ShouldLog(LastClimbingLogTime)) \
+		{ \
+			UE_LOG(LogClimbing, Verbosity, Format, ##__VA_ARGS__); \
+		} \
+	} while (0)
@@ -0,0 +1,237 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingLandscapeSampler.h"
+
+#include "LandscapeHeightfieldCollisionComponent.h"
+
+namespace ClimbingLandscape
+{
+	/** Height of the vertices in a hole of the landscape */
+	static constexpr float NoHeight = MAX_flt;
+
+	/** Bisections of the segment the probe crosses the surface in */
+	static constexpr int32 RefineSteps = 6;
+}
+
+FClimbingLandscapeSampler::FClimbingLandscapeSampler()
+	: SizeQuads(0)
+	, QuadSize(1.f)
+	, NextTile(0)
+{
+}
+
+void FClimbingLandscapeSampler::Reset()
+{
+	Component.Reset();
+	Tiles.Reset();
+	NextTile = 0;
+}
+
+bool FClimbingLandscapeSampler::CanSample(const UPrimitiveComponent* InComponent)
+{
+	const ULandscapeHeightfieldCollisionComponent* Landscape = Cast<ULandscapeHeightfieldCollisionComponent>(InComponent);
+	return Landscape && Landscape->CollisionSizeQuads > 0 && Landscape->CookedPhysicalMaterials.Num() <= 1;
+}
+
+bool FClimbingLandscapeSampler::Raycast(ULandscapeHeightfieldCollisionComponent* InComponent, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+	if (!CanSample(InComponent))
+	{
+		return false;
+	}
+
+	if (Component.Get() != InComponent)
+	{
+		Reset();
+		Component = InComponent;
+		SizeQuads = InComponent->CollisionSizeQuads;
+		QuadSize = FMath::Max(InComponent->CollisionScale, KINDA_SMALL_NUMBER);
+	}
+
+	const FTransform& ComponentToWorld = InComponent->GetComponentTransform();
+	const FVector LocalStart = ComponentToWorld.InverseTransformPosition(Start);
+	const FVector LocalEnd = ComponentToWorld.InverseTransformPosition(End);
+
+	// A probe starting under the surface is inside a cliff or under an overhang the heightfield can't have
+	float PreviousGap;
+	if (!GetGap(LocalStart, LocalEnd, 0.f, PreviousGap) || PreviousGap <= 0.f)
+	{
+		return false;
+	}
+
+	// Two samples per quad crossed, so a probe can't go through a narrow ridge between them
+	const float Length = FVector2D(LocalEnd - LocalStart).Size();
+	const int32 NumSteps = FMath::Max(FMath::CeilToInt(2.f * Length / QuadSize), 1);
+	float PreviousTime = 0.f;
+	for (int32 Step = 1; Step <= NumSteps; ++Step)
+	{
+		const float Time = static_cast<float>(Step) / NumSteps;
+		float Gap;
+		if (!GetGap(LocalStart, LocalEnd, Time, Gap))
+		{
+			return false;
+		}
+
+		if (Gap > 0.f)
+		{
+			PreviousTime = Time;
+			continue;
+		}
+
+		float MinTime = PreviousTime;
+		float MaxTime = Time;
+		for (int32 Refine = 0; Refine < ClimbingLandscape::RefineSteps; ++Refine)
+		{
+			const float MidTime = 0.5f * (MinTime + MaxTime);
+			float MidGap;
+			if (!GetGap(LocalStart, LocalEnd, MidTime, MidGap))
+			{
+				return false;
+			}
+			(MidGap > 0.f ? MinTime : MaxTime) = MidTime;
+		}
+
+		const FVector LocalLocation = FMath::Lerp(LocalStart, LocalEnd, MaxTime);
+		float Height;
+		FVector2D Gradient;
+		if (!SampleSurface(LocalLocation.X, LocalLocation.Y, Height, Gradient))
+		{
+			return false;
+		}
+
+		// The tangents carry the scale of the landscape, the normal is perpendicular to both in world space
+		const FVector TangentX = ComponentToWorld.TransformVector(FVector(1.f, 0.f, Gradient.X));
+		const FVector TangentY = ComponentToWorld.TransformVector(FVector(0.f, 1.f, Gradient.Y));
+		FVector Normal = FVector::CrossProduct(TangentX, TangentY).GetSafeNormal();
+		if (FVector::DotProduct(Normal, ComponentToWorld.GetUnitAxis(EAxis::Z)) < 0.f)
+		{
+			Normal = -Normal;
+		}
+
+		const FVector Location = FMath::Lerp(Start, End, MaxTime);
+		OutHit = FHitResult(Start, End);
+		OutHit.bBlockingHit = true;
+		OutHit.Time = MaxTime;
+		OutHit.Distance = (Location - Start).Size();
+		OutHit.Location = Location;
+		OutHit.ImpactPoint = Location;
+		OutHit.Normal = Normal;
+		OutHit.ImpactNormal = Normal;
+		OutHit.Component = InComponent;
+		OutHit.Actor = InComponent->GetOwner();
+		OutHit.PhysMaterial = InComponent->CookedPhysicalMaterials.Num() > 0 ? InComponent->CookedPhysicalMaterials[0] : nullptr;
+		return true;
+	}
+
+	return false;
+}
+
+bool FClimbingLandscapeSampler::GetGap(const FVector& LocalStart, const FVector& LocalEnd, float Time, float& OutGap)
+{
+	const FVector Point = FMath::Lerp(LocalStart, LocalEnd, Time);
+	float Height;
+	FVector2D Gradient;
+	if (!SampleSurface(Point.X, Point.Y, Height, Gradient))
+	{
+		return false;
+	}
+
+	OutGap = Point.Z - Height;
+	return true;
+}
+
+bool FClimbingLandscapeSampler::SampleSurface(float X, float Y, float& OutHeight, FVector2D& OutGradient)
+{
+	const float U = X / QuadSize;
+	const float V = Y / QuadSize;
+	if (U < 0.f || V < 0.f || U > SizeQuads || V > SizeQuads)
+	{
+		return false;
+	}
+
+	const FIntPoint Quad(FMath::Min(FMath::FloorToInt(U), SizeQuads - 1), FMath::Min(FMath::FloorToInt(V), SizeQuads - 1));
+	const float AlphaU = U - Quad.X;
+	const float AlphaV = V - Quad.Y;
+
+	float Heights[4];
+	FVector2D Gradients[4];
+	const FIntPoint Corners[4] = {Quad, Quad + FIntPoint(1, 0), Quad + FIntPoint(0, 1), Quad + FIntPoint(1, 1)};
+	for (int32 Corner = 0; Corner < 4; ++Corner)
+	{
+		if (!GetVertexHeight(Corners[Corner], Heights[Corner]) || !GetVertexGradient(Corners[Corner], Gradients[Corner]))
+		{
+			return false;
+		}
+	}
+
+	OutHeight = FMath::BiLerp(Heights[0], Heights[1], Heights[2], Heights[3], AlphaU, AlphaV);
+	OutGradient = FMath::BiLerp(Gradients[0], Gradients[1], Gradients[2], Gradients[3], AlphaU, AlphaV);
+	return true;
+}
+
+bool FClimbingLandscapeSampler::GetVertexGradient(const FIntPoint& Vertex, FVector2D& OutGradient)
+{
+	const FIntPoint MinX(FMath::Max(Vertex.X - 1, 0), Vertex.Y);
+	const FIntPoint MaxX(FMath::Min(Vertex.X + 1, SizeQuads), Vertex.Y);
+	const FIntPoint MinY(Vertex.X, FMath::Max(Vertex.Y - 1, 0));
+	const FIntPoint MaxY(Vertex.X, FMath::Min(Vertex.Y + 1, SizeQuads));
+
+	float HeightMinX, HeightMaxX, HeightMinY, HeightMaxY;
+	if (!GetVertexHeight(MinX, HeightMinX) || !GetVertexHeight(MaxX, HeightMaxX) ||
+	    !GetVertexHeight(MinY, HeightMinY) || !GetVertexHeight(MaxY, HeightMaxY))
+	{
+		return false;
+	}
+
+	OutGradient.X = (HeightMaxX - HeightMinX) / ((MaxX.X - MinX.X) * QuadSize);
+	OutGradient.Y = (HeightMaxY - HeightMinY) / ((MaxY.Y - MinY.Y) * QuadSize);
+	return true;
+}
+
+bool FClimbingLandscapeSampler::GetVertexHeight(const FIntPoint& Vertex, float& OutHeight)
+{
+	const FIntPoint Origin((Vertex.X / TileSize) * TileSize, (Vertex.Y / TileSize) * TileSize);
+	const FTile* Tile = Tiles.FindByPredicate([&Origin](const FTile& Candidate) { return Candidate.Origin == Origin; });
+	if (!Tile)
+	{
+		Tile = &LoadTile(Origin);
+	}
+
+	OutHeight = Tile->Heights[(Vertex.Y - Origin.Y) * TileSize + (Vertex.X - Origin.X)];
+	return OutHeight != ClimbingLandscape::NoHeight;
+}
+
+const FClimbingLandscapeSampler::FTile& FClimbingLandscapeSampler::LoadTile(const FIntPoint& Origin)
+{
+	if (Tiles.Num() < MaxTiles)
+	{
+		Tiles.AddDefaulted();
+		NextTile = Tiles.Num() - 1;
+	}
+
+	FTile& Tile = Tiles[NextTile];
+	NextTile = (NextTile + 1) % MaxTiles;
+
+	Tile.Origin = Origin;
+	Tile.Heights.SetNumUninitialized(TileSize * TileSize);
+
+	// Vertices past the border of the component belong to the next one, they are never read.
+	// The heights come back in world space, they are brought in the component space of the probes
+	ULandscapeHeightfieldCollisionComponent* Landscape = Component.Get();
+	const float BaseHeight = Landscape ? Landscape->GetComponentLocation().Z : 0.f;
+	const float HeightScale = Landscape ? Landscape->GetComponentScale().Z : 1.f;
+	for (int32 Y = 0; Y < TileSize; ++Y)
+	{
+		for (int32 X = 0; X < TileSize; ++X)
+		{
+			const FIntPoint Vertex = Origin + FIntPoint(X, Y);
+			TOptional<float> Height;
+			if (Landscape && Vertex.X <= SizeQuads && Vertex.Y <= SizeQuads)
+			{
+				Height = Landscape->GetHeight(Vertex.X * QuadSize, Vertex.Y * QuadSize, EHeightfieldSource::Complex);
+			}
+			Tile.Heights[Y * TileSize + X] = Height.IsSet() && HeightScale != 0.f ? (Height.GetValue() - BaseHeight) / HeightScale : ClimbingLandscape::NoHeight;
+		}
+	}
+	return Tile;
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ULandscapeHeightfieldCollisionComponent;
+class UPrimitiveComponent;
+
+/**
+ * Answers the climbing probes on a landscape from its height data instead of sweeps. The probe is marched
+ * over the collision heightfield of one component, and the normal at the crossing is interpolated from the
+ * normals of the four vertices around it, so it turns smoothly from a quad to the next. Heights are read
+ * in tiles of vertices, kept until the climber moves on to other tiles.
+ */
+class FClimbingLandscapeSampler
+{
+public:
+	FClimbingLandscapeSampler();
+
+	/** Forgets the component and its tiles */
+	void Reset();
+
+	/** Can the probes on this component be answered? Only landscapes with a single physical material are,
+	 *  the material of each layer is only known to the sweeps */
+	static bool CanSample(const UPrimitiveComponent* Component);
+
+	/** Finds where a probe enters the surface of a landscape component
+	 *  @return False if the probe misses, leaves the component or starts under the surface, the probe has to be traced then
+	 */
+	bool Raycast(ULandscapeHeightfieldCollisionComponent* InComponent, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+private:
+	/** Vertices on each side of a tile */
+	static constexpr int32 TileSize = 8;
+
+	/** Tiles kept at once, the oldest is replaced */
+	static constexpr int32 MaxTiles = 4;
+
+	struct FTile
+	{
+		FIntPoint Origin = FIntPoint::ZeroValue;
+		TArray<float> Heights;
+	};
+
+	/** Height of the surface over the point of a probe, in the component space */
+	bool GetGap(const FVector& LocalStart, const FVector& LocalEnd, float Time, float& OutGap);
+
+	/** Bilinear height and gradient of the surface at a point of the component space */
+	bool SampleSurface(float X, float Y, float& OutHeight, FVector2D& OutGradient);
+
+	/** Height gradient at a vertex, one sided on the border of the component */
+	bool GetVertexGradient(const FIntPoint& Vertex, FVector2D& OutGradient);
+
+	bool GetVertexHeight(const FIntPoint& Vertex, float& OutHeight);
+
+	/** Reads the heights of the tile holding a vertex */
+	const FTile& LoadTile(const FIntPoint& Origin);
+
+	TWeakObjectPtr<ULandscapeHeightfieldCollisionComponent> Component;
+
+	/** Quads on each side of the collision heightfield of the component, and their size in the component space */
+	int32 SizeQuads;
+	float QuadSize;
+
+	TArray<FTile, TInlineAllocator<MaxTiles>> Tiles;
+	int32 NextTile;
+};
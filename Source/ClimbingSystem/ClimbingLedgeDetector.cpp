@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingLedgeDetector.h"
+
+FClimbingLedgeDetector::FClimbingLedgeDetector()
+{
+	Reset();
+}
+
+void FClimbingLedgeDetector::Reset()
+{
+	State = EState::ScanningEdge;
+	bProbePending = false;
+	ScanOrigin = FVector::ZeroVector;
+	ScanForward = FVector::ZeroVector;
+	ScanUp = FVector::ZeroVector;
+	ScannedHeight = -BIG_NUMBER;
+	PendingHeight = 0.f;
+	EdgeHeight = 0.f;
+	ClearanceLocation = FVector::ZeroVector;
+}
+
+void FClimbingLedgeDetector::Restart(const FClimbingLedgeFrame& Frame)
+{
+	Reset();
+	ScanOrigin = Frame.Location;
+	ScanForward = Frame.Forward;
+	ScanUp = Frame.Up;
+}
+
+bool FClimbingLedgeDetector::IsOnScanLine(const FClimbingLedgeFrame& Frame) const
+{
+	if (ScanUp.IsZero())
+	{
+		return false;
+	}
+
+	// Moving up and down the scan line keeps the scan, moving sideways or turning starts a new one
+	const FVector Delta = Frame.Location - ScanOrigin;
+	const FVector LateralDelta = Delta - ScanUp * FVector::DotProduct(Delta, ScanUp);
+	return LateralDelta.SizeSquared() <= FMath::Square(Frame.CapsuleRadius * 0.5f) &&
+		FVector::DotProduct(Frame.Forward, ScanForward) >= FMath::Cos(FMath::DegreesToRadians(10.f));
+}
+
+float FClimbingLedgeDetector::GetAheadHeight(const FClimbingLedgeFrame& Frame) const
+{
+	// The probe ahead of a climber going up is half a capsule height above it
+	return FVector::DotProduct(Frame.Location - ScanOrigin, ScanUp) + Frame.CapsuleHalfHeight;
+}
+
+float FClimbingLedgeDetector::GetScanStep(const FClimbingLedgeFrame& Frame)
+{
+	return Frame.CapsuleHalfHeight * 0.5f;
+}
+
+bool FClimbingLedgeDetector::GetNextProbe(const FClimbingLedgeFrame& Frame, FVector& OutStart, FVector& OutEnd, FCollisionShape& OutShape)
+{
+	if (bProbePending)
+	{
+		return false;
+	}
+
+	if (!IsOnScanLine(Frame) ||
+	    // The climber went past the edge without vaulting, there was a gap in the wall
+	    ((State == EState::Ready || State == EState::Blocked) && GetAheadHeight(Frame) > EdgeHeight + GetScanStep(Frame)))
+	{
+		Restart(Frame);
+	}
+
+	const float AheadHeight = GetAheadHeight(Frame);
+	switch (State)
+	{
+	case EState::ScanningEdge:
+	{
+		// The scan goes on from the last boxcast that hit the wall, up to the lookahead above the climber
+		const float Height = FMath::Max(ScannedHeight + GetScanStep(Frame), AheadHeight);
+		if (Height > AheadHeight + Frame.Lookahead)
+		{
+			return false;
+		}
+
+		PendingHeight = Height;
+		OutStart = ScanOrigin + ScanUp * Height;
+		OutEnd = OutStart + ScanForward * Frame.CapsuleRadius * 2.f;
+		OutShape = FCollisionShape::MakeBox(FVector(0.01f, 0.01f, 0.01f));
+		bProbePending = true;
+		return true;
+	}
+
+	case EState::CheckingClearance:
+		// Same capsule cast the vault does when the probe ahead leaves the wall at the edge
+		ClearanceLocation = ScanOrigin + ScanUp * (EdgeHeight + Frame.CapsuleHalfHeight) + ScanForward * Frame.CapsuleRadius * 2.f;
+		OutStart = ClearanceLocation;
+		OutEnd = ClearanceLocation;
+		OutShape = FCollisionShape::MakeCapsule(Frame.CapsuleRadius, Frame.CapsuleHalfHeight);
+		bProbePending = true;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+void FClimbingLedgeDetector::OnProbeResult(bool bValid, bool bHit)
+{
+	if (!bProbePending)
+	{
+		return;
+	}
+
+	bProbePending = false;
+	if (!bValid)
+	{
+		return;
+	}
+
+	if (State == EState::ScanningEdge)
+	{
+		if (bHit)
+		{
+			ScannedHeight = PendingHeight;
+			return;
+		}
+
+		EdgeHeight = PendingHeight;
+		State = EState::CheckingClearance;
+	}
+	else if (State == EState::CheckingClearance)
+	{
+		State = bHit ? EState::Blocked : EState::Ready;
+	}
+}
+
+bool FClimbingLedgeDetector::FindVault(const FClimbingLedgeFrame& Frame, bool& bOutCanVault, FVector& OutLocation) const
+{
+	if ((State != EState::Ready && State != EState::Blocked) || !IsOnScanLine(Frame))
+	{
+		return false;
+	}
+
+	// The probe ahead has to be leaving the wall at the edge that was found, not at a hole below it
+	const float AheadHeight = GetAheadHeight(Frame);
+	const float ScanStep = GetScanStep(Frame);
+	if (AheadHeight < EdgeHeight - ScanStep || AheadHeight > EdgeHeight + ScanStep)
+	{
+		return false;
+	}
+
+	bOutCanVault = State == EState::Ready;
+
+	// Location is basically the position that has been checked to be free plus a small offset forward
+	OutLocation = ClearanceLocation + ScanForward * 30.f - ScanForward * Frame.CapsuleRadius * 2.f;
+	return true;
+}
@@ -0,0 +1,94 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionShape.h"
+
+/** Pose of a climber, as seen by the ledge detector */
+struct FClimbingLedgeFrame
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Forward = FVector::ForwardVector;
+	FVector Up = FVector::UpVector;
+	float CapsuleRadius = 0.f;
+	float CapsuleHalfHeight = 0.f;
+
+	/** How far above the probe ahead of the climber the top of the wall is looked for */
+	float Lookahead = 0.f;
+};
+
+/**
+ * Looks for the top of the wall while the character climbs up, one probe per frame. The edge is
+ * scanned with boxcasts above the probe ahead of the climber, then the space on top of it is checked
+ * with a capsule cast, so the vault is decided before the wall runs out and starts without queries.
+ */
+class FClimbingLedgeDetector
+{
+public:
+	FClimbingLedgeDetector();
+
+	/** Drops the scan and anything found */
+	void Reset();
+
+	/** Computes the next probe of the scan, to be submitted with the climbing probes
+	 *  @return False if there is nothing to check from this pose, or the last probe is still pending
+	 */
+	bool GetNextProbe(const FClimbingLedgeFrame& Frame, FVector& OutStart, FVector& OutEnd, FCollisionShape& OutShape);
+
+	/** Feeds back the result of the last probe returned by GetNextProbe()
+	 *  @param bValid False if the result never came back, the probe is then issued again
+	 */
+	void OnProbeResult(bool bValid, bool bHit);
+
+	/** Returns the vault on the ledge found ahead, if it is the one the climber just reached
+	 *  @param bOutCanVault False if the ledge was found but there is no space on top of it
+	 *  @return True if the detector has an answer for this pose
+	 */
+	bool FindVault(const FClimbingLedgeFrame& Frame, bool& bOutCanVault, FVector& OutLocation) const;
+
+private:
+	enum class EState : uint8
+	{
+		/** Boxcasts going up until one misses the wall */
+		ScanningEdge,
+		/** Capsule cast on top of the edge */
+		CheckingClearance,
+		/** There is space to vault on top of the edge */
+		Ready,
+		/** The edge was found but there is no space on top of it */
+		Blocked,
+	};
+
+	/** Starts a new scan from the current pose of the climber */
+	void Restart(const FClimbingLedgeFrame& Frame);
+
+	/** Did the climber stay on the line the scan was made along? */
+	bool IsOnScanLine(const FClimbingLedgeFrame& Frame) const;
+
+	/** Height of the probe ahead of the climber, along the up vector of the scan */
+	float GetAheadHeight(const FClimbingLedgeFrame& Frame) const;
+
+	/** Height between two boxcasts of the edge scan */
+	static float GetScanStep(const FClimbingLedgeFrame& Frame);
+
+	EState State;
+	bool bProbePending;
+
+	/** Pose the scan started from, heights are measured along ScanUp from ScanOrigin */
+	FVector ScanOrigin;
+	FVector ScanForward;
+	FVector ScanUp;
+
+	/** Highest boxcast that hit the wall */
+	float ScannedHeight;
+
+	/** Height of the boxcast in flight */
+	float PendingHeight;
+
+	/** Height of the first boxcast that missed the wall, the top of the wall is below it */
+	float EdgeHeight;
+
+	/** Location of the capsule cast on top of the edge */
+	FVector ClearanceLocation;
+};
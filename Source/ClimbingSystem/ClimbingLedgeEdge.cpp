@@ -0,0 +1,183 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingLedgeEdge.h"
+
+#include "Components/PrimitiveComponent.h"
+
+namespace ClimbingLedgeEdge
+{
+	/** Cosine of the angle under which two segments, or two normals, are taken as the same */
+	static constexpr float InLineCos = 0.999f;
+}
+
+FClimbingLedgeEdge::FClimbingLedgeEdge()
+	: bStartOpen(false)
+	, bEndOpen(false)
+{
+}
+
+void FClimbingLedgeEdge::Reset()
+{
+	Component.Reset();
+	Points.Reset();
+	bStartOpen = false;
+	bEndOpen = false;
+}
+
+void FClimbingLedgeEdge::Start(UPrimitiveComponent* InComponent, const FClimbingLedgePoint& WorldPoint)
+{
+	Reset();
+	if (!InComponent)
+	{
+		return;
+	}
+
+	Component = InComponent;
+	bStartOpen = true;
+	bEndOpen = true;
+
+	const FTransform& ComponentToWorld = InComponent->GetComponentTransform();
+	FClimbingLedgePoint& Point = Points.AddDefaulted_GetRef();
+	Point.Location = ComponentToWorld.InverseTransformPosition(WorldPoint.Location);
+	Point.Normal = ComponentToWorld.InverseTransformVectorNoScale(WorldPoint.Normal);
+}
+
+void FClimbingLedgeEdge::AddPoint(bool bAtEnd, const FClimbingLedgePoint& WorldPoint)
+{
+	const UPrimitiveComponent* EdgeComponent = Component.Get();
+	if (!EdgeComponent || Points.Num() == 0)
+	{
+		return;
+	}
+
+	const FTransform& ComponentToWorld = EdgeComponent->GetComponentTransform();
+	FClimbingLedgePoint Point;
+	Point.Location = ComponentToWorld.InverseTransformPosition(WorldPoint.Location);
+	Point.Normal = ComponentToWorld.InverseTransformVectorNoScale(WorldPoint.Normal);
+
+	// The last point at this end goes if the edge carries straight on through it
+	if (Points.Num() >= 2)
+	{
+		const FClimbingLedgePoint& Last = bAtEnd ? Points.Last() : Points[0];
+		const FClimbingLedgePoint& BeforeLast = bAtEnd ? Points.Last(1) : Points[1];
+		const FVector LastDirection = (Last.Location - BeforeLast.Location).GetSafeNormal();
+		const FVector NewDirection = (Point.Location - Last.Location).GetSafeNormal();
+		if (FVector::DotProduct(LastDirection, NewDirection) >= ClimbingLedgeEdge::InLineCos &&
+		    FVector::DotProduct(Last.Normal, Point.Normal) >= ClimbingLedgeEdge::InLineCos)
+		{
+			(bAtEnd ? Points.Last() : Points[0]) = Point;
+			return;
+		}
+	}
+
+	if (bAtEnd)
+	{
+		Points.Add(Point);
+	}
+	else
+	{
+		Points.Insert(Point, 0);
+	}
+}
+
+void FClimbingLedgeEdge::CloseEnd(bool bAtEnd)
+{
+	(bAtEnd ? bEndOpen : bStartOpen) = false;
+}
+
+bool FClimbingLedgeEdge::IsValid() const
+{
+	return Points.Num() > 0 && Component.IsValid();
+}
+
+FClimbingLedgePoint FClimbingLedgeEdge::GetEndPoint(bool bAtEnd) const
+{
+	check(Points.Num() > 0);
+	return ToWorld(bAtEnd ? Points.Last() : Points[0]);
+}
+
+float FClimbingLedgeEdge::GetLength() const
+{
+	float Length = 0.f;
+	for (int32 Index = 1; Index < Points.Num(); ++Index)
+	{
+		Length += FVector::Dist(ToWorld(Points[Index - 1]).Location, ToWorld(Points[Index]).Location);
+	}
+	return Length;
+}
+
+float FClimbingLedgeEdge::Project(const FVector& WorldLocation) const
+{
+	if (Points.Num() < 2)
+	{
+		return 0.f;
+	}
+
+	float BestDistance = 0.f;
+	float BestDistSquared = MAX_flt;
+	float SegmentStart = 0.f;
+	FVector Start = ToWorld(Points[0]).Location;
+	for (int32 Index = 1; Index < Points.Num(); ++Index)
+	{
+		const FVector End = ToWorld(Points[Index]).Location;
+		const FVector Closest = FMath::ClosestPointOnSegment(WorldLocation, Start, End);
+		const float DistSquared = FVector::DistSquared(Closest, WorldLocation);
+		if (DistSquared < BestDistSquared)
+		{
+			BestDistSquared = DistSquared;
+			BestDistance = SegmentStart + FVector::Dist(Start, Closest);
+		}
+
+		SegmentStart += FVector::Dist(Start, End);
+		Start = End;
+	}
+	return BestDistance;
+}
+
+FClimbingLedgePoint FClimbingLedgeEdge::Evaluate(float Distance) const
+{
+	check(Points.Num() > 0);
+	if (Points.Num() == 1 || Distance <= 0.f)
+	{
+		return ToWorld(Points[0]);
+	}
+
+	float SegmentStart = 0.f;
+	for (int32 Index = 1; Index < Points.Num(); ++Index)
+	{
+		const FClimbingLedgePoint Start = ToWorld(Points[Index - 1]);
+		const FClimbingLedgePoint End = ToWorld(Points[Index]);
+		const float SegmentLength = FVector::Dist(Start.Location, End.Location);
+		if (Distance <= SegmentStart + SegmentLength)
+		{
+			// The facing turns smoothly from a point to the next, so the hanging rotation does not jump along the segment.
+			// Opposite normals blend to nothing, the one of the closest point is kept then
+			const float Alpha = SegmentLength > KINDA_SMALL_NUMBER ? (Distance - SegmentStart) / SegmentLength : 0.f;
+			FClimbingLedgePoint Point;
+			Point.Location = FMath::Lerp(Start.Location, End.Location, Alpha);
+			Point.Normal = FMath::Lerp(Start.Normal, End.Normal, Alpha).GetSafeNormal();
+			if (Point.Normal.IsZero())
+			{
+				Point.Normal = Alpha < 0.5f ? Start.Normal : End.Normal;
+			}
+			return Point;
+		}
+		SegmentStart += SegmentLength;
+	}
+	return ToWorld(Points.Last());
+}
+
+FClimbingLedgePoint FClimbingLedgeEdge::ToWorld(const FClimbingLedgePoint& LocalPoint) const
+{
+	const UPrimitiveComponent* EdgeComponent = Component.Get();
+	if (!EdgeComponent)
+	{
+		return LocalPoint;
+	}
+
+	const FTransform& ComponentToWorld = EdgeComponent->GetComponentTransform();
+	FClimbingLedgePoint Point;
+	Point.Location = ComponentToWorld.TransformPosition(LocalPoint.Location);
+	Point.Normal = ComponentToWorld.TransformVectorNoScale(LocalPoint.Normal);
+	return Point;
+}
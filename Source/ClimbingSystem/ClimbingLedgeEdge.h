@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+
+/** Point of a ledge edge: the top of the wall, and the horizontal normal of its face */
+struct FClimbingLedgePoint
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+};
+
+/**
+ * Top edge of the wall a climber hangs from, kept as a polyline in the space of the component it was found on.
+ * It starts from the point grabbed and is scanned a few points at a time while the climber shimmies towards an
+ * open end; the part already scanned is walked along without tracing the wall. An end is closed where the ledge stops.
+ * The start of the edge is on the left of the climber, the end on its right.
+ */
+class FClimbingLedgeEdge
+{
+public:
+	FClimbingLedgeEdge();
+
+	/** Forgets the edge */
+	void Reset();
+
+	/** Starts an edge on a component, with a point found in world space. Both ends are open */
+	void Start(UPrimitiveComponent* InComponent, const FClimbingLedgePoint& WorldPoint);
+
+	/** Adds a point found in world space at an end of the edge. A point in line with the last segment replaces its end,
+	 *  so only the corners are kept */
+	void AddPoint(bool bAtEnd, const FClimbingLedgePoint& WorldPoint);
+
+	/** Marks an end as the real end of the ledge, it is not scanned further */
+	void CloseEnd(bool bAtEnd);
+
+	bool IsEndOpen(bool bAtEnd) const { return bAtEnd ? bEndOpen : bStartOpen; }
+
+	/** Is there an edge, on a component still alive? */
+	bool IsValid() const;
+
+	UPrimitiveComponent* GetComponent() const { return Component.Get(); }
+
+	/** Point at an end of the edge, in world space */
+	FClimbingLedgePoint GetEndPoint(bool bAtEnd) const;
+
+	/** Length of the edge in world space */
+	float GetLength() const;
+
+	/** Distance along the edge of its point closest to a location */
+	float Project(const FVector& WorldLocation) const;
+
+	/** Point at a distance along the edge in world space, clamped to its ends */
+	FClimbingLedgePoint Evaluate(float Distance) const;
+
+private:
+	FClimbingLedgePoint ToWorld(const FClimbingLedgePoint& LocalPoint) const;
+
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	/** Corners of the edge in the component space, from the start to the end */
+	TArray<FClimbingLedgePoint> Points;
+
+	bool bStartOpen;
+	bool bEndOpen;
+};
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingLimbIK.h"
+
+#include "Engine/World.h"
+
+void FClimbingLimbTraces::AddTrace(EClimbingLimb Limb, const FVector& Start, const FVector& End)
+{
+	FQueuedTrace& Trace = Queued[static_cast<int32>(Limb)];
+	Trace.Start = Start;
+	Trace.End = End;
+	Trace.bQueued = true;
+}
+
+int32 FClimbingLimbTraces::Submit(UWorld* World, const FTransform& ComponentTransform, ECollisionChannel Channel, const FCollisionQueryParams& Params)
+{
+	check(World);
+	SubmittedTransform = ComponentTransform;
+	int32 NumSubmitted = 0;
+
+	for (int32 Index = 0; Index < NumLimbs; ++Index)
+	{
+		FQueuedTrace& Trace = Queued[Index];
+		if (!Trace.bQueued)
+		{
+			continue;
+		}
+
+		Handles[Index] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Trace.Start, Trace.End, Channel, Params);
+		Trace.bQueued = false;
+		++NumSubmitted;
+	}
+
+	return NumSubmitted;
+}
+
+int32 FClimbingLimbTraces::Consume(UWorld* World)
+{
+	check(World);
+	int32 NumConsumed = 0;
+
+	for (int32 Index = 0; Index < NumLimbs; ++Index)
+	{
+		FTraceDatum Datum;
+		if (!Handles[Index].IsValid() || !World->QueryTraceData(Handles[Index], Datum))
+		{
+			continue;
+		}
+
+		FClimbingLimbContact& Contact = Contacts[Index];
+		Contact.bHit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+		if (Contact.bHit)
+		{
+			Contact.Location = SubmittedTransform.InverseTransformPosition(Datum.OutHits[0].ImpactPoint);
+			Contact.Normal = SubmittedTransform.InverseTransformVectorNoScale(Datum.OutHits[0].ImpactNormal);
+		}
+		Handles[Index] = FTraceHandle();
+		++NumConsumed;
+	}
+
+	return NumConsumed;
+}
+
+void FClimbingLimbTraces::Reset()
+{
+	for (int32 Index = 0; Index < NumLimbs; ++Index)
+	{
+		Queued[Index] = FQueuedTrace();
+		Handles[Index] = FTraceHandle();
+		Contacts[Index] = FClimbingLimbContact();
+	}
+}
+
+float ClimbingLimbIK::GetScreenSize(float SphereRadius, float Distance, float FOVAngle)
+{
+	const float HalfFOVTan = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(FOVAngle, 1.f, 170.f) * 0.5f));
+	return SphereRadius / FMath::Max(Distance * HalfFOVTan, 1.f);
+}
+
+int32 ClimbingLimbIK::GetTraceInterval(float ScreenSize, float FullRateScreenSize, float MinScreenSize, int32 MaxInterval)
+{
+	if (ScreenSize >= FullRateScreenSize)
+	{
+		return 1;
+	}
+	if (ScreenSize < MinScreenSize || FullRateScreenSize <= MinScreenSize)
+	{
+		return 0;
+	}
+
+	const float Alpha = (FullRateScreenSize - ScreenSize) / (FullRateScreenSize - MinScreenSize);
+	return FMath::Clamp(1 + FMath::RoundToInt(Alpha * (MaxInterval - 1)), 1, FMath::Max(MaxInterval, 1));
+}
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+
+/** Limbs placed on the wall while climbing */
+enum class EClimbingLimb : uint8
+{
+	HandLeft,
+	HandRight,
+	FootLeft,
+	FootRight,
+
+	Num
+};
+
+/** Contact of a limb with the wall */
+struct FClimbingLimbContact
+{
+	/** Point on the wall, in the space of the mesh component when the trace was submitted */
+	FVector Location = FVector::ZeroVector;
+	FVector Normal = FVector::ZeroVector;
+
+	/** True if the last trace of the limb found the wall */
+	bool bHit = false;
+};
+
+/**
+ * Placement traces of the limbs of a climber, submitted together as async line traces and read back the
+ * next frame. Contacts are kept in component space, so limbs whose traces are not refreshed follow the mesh.
+ */
+class FClimbingLimbTraces
+{
+public:
+	static constexpr int32 NumLimbs = static_cast<int32>(EClimbingLimb::Num);
+
+	/** Queues a trace, in world space. It is issued on the next Submit() */
+	void AddTrace(EClimbingLimb Limb, const FVector& Start, const FVector& End);
+
+	/** Issues every queued trace to the async trace system
+	 *  @param ComponentTransform Transform of the mesh the contacts will be relative to
+	 *  @return Number of traces issued
+	 */
+	int32 Submit(UWorld* World, const FTransform& ComponentTransform, ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	/** Reads back the traces submitted last frame. Limbs with no trace in flight keep their contact
+	 *  @return Number of traces that came back
+	 */
+	int32 Consume(UWorld* World);
+
+	const FClimbingLimbContact& GetContact(EClimbingLimb Limb) const { return Contacts[static_cast<int32>(Limb)]; }
+
+	/** Drops queued traces, pending handles and contacts */
+	void Reset();
+
+private:
+	struct FQueuedTrace
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		bool bQueued = false;
+	};
+
+	FQueuedTrace Queued[NumLimbs];
+	FTraceHandle Handles[NumLimbs];
+	FClimbingLimbContact Contacts[NumLimbs];
+
+	/** Component transform of the traces in flight */
+	FTransform SubmittedTransform;
+};
+
+namespace ClimbingLimbIK
+{
+	/** Approximate fraction of the screen height covered by a sphere */
+	float GetScreenSize(float SphereRadius, float Distance, float FOVAngle);
+
+	/** Frames between two trace submissions of a climber: 1 at FullRateScreenSize and above, up to MaxInterval
+	 *  at MinScreenSize, and 0 below it, meaning the contacts are frozen
+	 */
+	int32 GetTraceInterval(float ScreenSize, float FullRateScreenSize, float MinScreenSize, int32 MaxInterval);
+}
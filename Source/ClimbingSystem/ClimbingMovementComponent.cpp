@@ -0,0 +1,1797 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingMovementComponent.h"
+
+#include "ClimbableSurfaceIndex.h"
+#include "ClimbingDebug.h"
+#include "ClimbingPlaneFit.h"
+#include "ClimbingStats.h"
+#include "ClimbingSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/RootMotionSource.h"
+#include "LandscapeHeightfieldCollisionComponent.h"
+
+namespace ClimbingMovement
+{
+	/** Names of the root motion sources of the climbing transitions, by EClimbingTransition */
+	static const FName TransitionMoveNames[] = {TEXT("ClimbingAttach"), TEXT("ClimbingReattach"), TEXT("ClimbingVault"), TEXT("ClimbingHang")};
+	static_assert(UE_ARRAY_COUNT(TransitionMoveNames) == static_cast<int32>(EClimbingTransition::Num), "One name for each transition");
+
+	static const FName& GetMoveName(EClimbingTransition Transition)
+	{
+		return TransitionMoveNames[static_cast<int32>(Transition)];
+	}
+}
+
+UClimbingMovementComponent::UClimbingMovementComponent()
+{
+	// Set the allowed angles for climbing
+	MinClimbAngle = -75.f;
+	MaxClimbAngle = 45.f;
+	MaxTurnAngle = 65.f;
+
+	MaxClimbSpeed = 600.f;
+	BrakingDecelerationClimbing = 2048.f;
+	ClimbRotationInterpSpeed = 5.f;
+	LedgeLookaheadDistance = 150.f;
+	SurfaceProbeGridSize = 3;
+	SurfaceProbeSpacing = 0.5f;
+	SurfaceFitOutlierDistance = 10.f;
+	WallJumpVelocity = 600.f;
+	AttachDuration = 0.2f;
+	VaultDuration = 0.5f;
+	AttachTimeCurve = nullptr;
+	VaultTimeCurve = nullptr;
+	VaultPathCurve = nullptr;
+	bFixedStepClimbing = false;
+	ClimbingStepRate = 30.f;
+	MaxClimbingStepsPerFrame = 4;
+	bSampleLandscapeHeight = true;
+	bLedgeHang = true;
+	HangVerticalOffset = 100.f;
+	HangShimmySpeed = 150.f;
+	LedgeScanDistance = 200.f;
+	LedgeScanSamplesPerFrame = 1;
+	LedgeScanSpacing = 25.f;
+	SurfaceCacheDistanceTolerance = 25.f;
+	SurfaceCacheAngleTolerance = 5.f;
+
+	bClimbing = false;
+	bWantsToClimb = false;
+	bWantsWallJump = false;
+	bReattachAtApex = false;
+	WallJumpOutcome = EClimbingWallJumpOutcome::Pending;
+	WallJumpVaultLocation = FVector::ZeroVector;
+	bWantsVaultProbe = false;
+	bHasWallSurface = false;
+	WallSurfaceLocation = FVector::ZeroVector;
+	WallSurfaceNormal = FVector::ZeroVector;
+
+	bHasBatchSolve = false;
+	BatchSolveInput = FVector2D::ZeroVector;
+	BatchSolveLocation = FVector::ZeroVector;
+
+	ClimbingStepAccumulator = 0.f;
+	PreviousStepLocation = FVector::ZeroVector;
+	PreviousStepRotation = FQuat::Identity;
+	bClimbingStepVisuals = false;
+	bLandscapeSamplingSuspended = false;
+	bHangClimbUpTried = false;
+
+	for (TSharedPtr<FRootMotionSource_MoveToDynamicForce>& Move : TransitionMoves)
+	{
+		Move = MakeShared<FRootMotionSource_MoveToDynamicForce>();
+	}
+
+	SetNetworkMoveDataContainer(ClimbingMoveDataContainer);
+}
+
+bool UClimbingMovementComponent::IsClimbing() const
+{
+	return MovementMode == EMovementMode::MOVE_Custom && CustomMovementMode == CMOVE_Climbing;
+}
+
+bool UClimbingMovementComponent::IsHanging() const
+{
+	return MovementMode == EMovementMode::MOVE_Custom && CustomMovementMode == CMOVE_Hanging;
+}
+
+bool UClimbingMovementComponent::StartRecording(const FString& Filename)
+{
+	FClimbingRecordingHeader Header;
+	Header.MapName = GetWorld() ? UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName()) : FString();
+	Header.MinClimbAngle = MinClimbAngle;
+	Header.MaxClimbAngle = MaxClimbAngle;
+	Header.MaxTurnAngle = MaxTurnAngle;
+
+	Recorder = FClimbingRecorder::Create(Filename, Header);
+	if (!Recorder)
+	{
+		return false;
+	}
+
+	UE_LOG(LogClimbing, Display, TEXT("Recording climbing to %s"), *Filename);
+	return true;
+}
+
+void UClimbingMovementComponent::StopRecording()
+{
+	if (Recorder)
+	{
+		UE_LOG(LogClimbing, Display, TEXT("Recorded %d climbing frames to %s"), Recorder->GetNumFrames(), *Recorder->GetFilename());
+		Recorder.Reset();
+	}
+}
+
+void UClimbingMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bClimbingStepVisuals || (bFixedStepClimbing && IsClimbing()))
+	{
+		UpdateClimbingStepVisuals();
+	}
+
+	if (Recorder)
+	{
+		Recorder->EndFrame(DeltaTime);
+	}
+}
+
+void UClimbingMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopRecording();
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UClimbingMovementComponent::IsVaulting() const
+{
+	for (const TSharedPtr<FRootMotionSource>& Source : CurrentRootMotion.RootMotionSources)
+	{
+		if (Source.IsValid() && Source->InstanceName == ClimbingMovement::GetMoveName(EClimbingTransition::Vault))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UClimbingMovementComponent::TryAttachToWall()
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingAttach);
+
+	// A grab in the air, as at the apex of a wall jump, has its own move
+	const EClimbingTransition Transition = IsFalling() ? EClimbingTransition::Reattach : EClimbingTransition::Attach;
+
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	const FVector End = Start + (GetCapsuleRadius()*3.f*UpdatedComponent->GetForwardVector());
+
+	// The wall at the apex of a wall jump was probed on the way up
+	FHitResult PredictedWallHit;
+	if (Transition == EClimbingTransition::Reattach && WallJumpPredictor.GetWallHit(Start, End, PredictedWallHit))
+	{
+		WallJumpPredictor.Reset();
+		AttachToWall(PredictedWallHit, Transition);
+		return true;
+	}
+	WallJumpPredictor.Reset();
+
+	// Check if there is a wall in front of the character
+	FHitResult WallTraceHitResult;
+	if (!WallTrace(WallTraceHitResult, Start, End, FColor::Green) || !GetSurfaceRules(WallTraceHitResult).bClimbable)
+	{
+		// If there is not a wall in front of the character, make sure to detach
+		DetachFromWall();
+		return false;
+	}
+
+	AttachToWall(WallTraceHitResult, Transition);
+	return true;
+}
+
+void UClimbingMovementComponent::AttachToWall(const FHitResult& WallHit, EClimbingTransition Transition)
+{
+	// There is a wall in front of the character, start climbing,
+	// stop movement and stop orienting the rotation to the movement
+	SetMovementMode(EMovementMode::MOVE_Custom, CMOVE_Climbing);
+	StopMovementImmediately();
+	bOrientRotationToMovement = false;
+
+	const FVector TargetPosition =
+		GetCapsuleRadius() * WallHit.Normal + WallHit.Location;
+
+	// Until the first probe batch comes back, climbing extrapolates from this wall. The attach is always
+	// traced, the surface index knows nothing of the movable objects that may be in front of a static wall
+	ProbeBatch.Reset();
+	SurfaceCache.Reset();
+	LedgeDetector.Reset();
+	SurfaceCache.Store(EClimbingProbe::Wall, WallHit);
+	UpdateWallSurface(WallHit);
+	UpdateClimbingBase();
+
+	// Move the character to the wall, the rotation to face it follows the wall normal while climbing
+	ApplyClimbingMove(Transition, TargetPosition);
+}
+
+void UClimbingMovementComponent::DetachFromWall()
+{
+	CancelAttachMoves();
+	bClimbing = false;
+	bWantsToClimb = false;
+	if (IsClimbing() || IsHanging())
+	{
+		SetMovementMode(EMovementMode::MOVE_Walking);
+	}
+
+	bOrientRotationToMovement = true;
+	ResetRotation();
+}
+
+void UClimbingMovementComponent::SetWantsToClimb(bool bInWantsToClimb)
+{
+	bWantsToClimb = bInWantsToClimb;
+}
+
+void UClimbingMovementComponent::RequestWallJump()
+{
+	bWantsWallJump = true;
+}
+
+float UClimbingMovementComponent::GetMaxSpeed() const
+{
+	if (IsClimbing())
+	{
+		return MaxClimbSpeed * WallSurfaceRules.SpeedScale;
+	}
+	if (IsHanging())
+	{
+		return HangShimmySpeed;
+	}
+	return Super::GetMaxSpeed();
+}
+
+float UClimbingMovementComponent::GetMaxBrakingDeceleration() const
+{
+	if (IsClimbing())
+	{
+		return BrakingDecelerationClimbing;
+	}
+	return Super::GetMaxBrakingDeceleration();
+}
+
+void UClimbingMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	// Simulated proxies get the climbing state from the replicated movement mode
+	if (CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		return;
+	}
+
+	if (bWantsWallJump)
+	{
+		bWantsWallJump = false;
+		if (IsClimbing())
+		{
+			WallJump();
+			return;
+		}
+	}
+
+	if (bReattachAtApex && IsFalling())
+	{
+		UpdateWallJumpPrediction();
+	}
+
+	if (bWantsToClimb && !IsClimbing() && !IsHanging())
+	{
+		// Nothing to grab, the request is dropped
+		bWantsToClimb = (IsMovingOnGround() || IsFalling()) && TryAttachToWall();
+	}
+	else if (!bWantsToClimb && (IsClimbing() || IsHanging()))
+	{
+		DetachFromWall();
+	}
+}
+
+void UClimbingMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	bWantsToClimb = (Flags & FSavedMove_Climbing::FLAG_WantsToClimb) != 0;
+	bWantsWallJump = (Flags & FSavedMove_Climbing::FLAG_WallJump) != 0;
+
+	// The outcome of the wall jump is not a flag, it comes with the move data
+	if (const FClimbingNetworkMoveData* MoveData = static_cast<const FClimbingNetworkMoveData*>(GetCurrentNetworkMoveData()))
+	{
+		AcceptClientWallJumpOutcome(MoveData->WallJumpOutcome, MoveData->WallJumpVaultLocation);
+	}
+}
+
+void UClimbingMovementComponent::NotifyJumpApex()
+{
+	Super::NotifyJumpApex();
+
+	// Only when the character traveled the max distance, will be able to reattach to a wall. A vault or a drop
+	// decided in this move is still applied at the start of the next one
+	if (bReattachAtApex && (WallJumpOutcome == EClimbingWallJumpOutcome::Reattach || WallJumpOutcome == EClimbingWallJumpOutcome::Pending))
+	{
+		bReattachAtApex = false;
+		WallJumpOutcome = EClimbingWallJumpOutcome::Pending;
+		bWantsToClimb = true;
+	}
+}
+
+FNetworkPredictionData_Client* UClimbingMovementComponent::GetPredictionData_Client() const
+{
+	if (!ClientPredictionData)
+	{
+		UClimbingMovementComponent* MutableThis = const_cast<UClimbingMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Climbing(*this);
+	}
+	return ClientPredictionData;
+}
+
+void UClimbingMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
+{
+	if (CustomMovementMode == CMOVE_Climbing)
+	{
+		PhysClimbing(deltaTime, Iterations);
+	}
+	else if (CustomMovementMode == CMOVE_Hanging)
+	{
+		PhysHanging(deltaTime, Iterations);
+	}
+
+	Super::PhysCustom(deltaTime, Iterations);
+}
+
+void UClimbingMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	// Climbers are solved and their probes submitted by the subsystem
+	const bool bWasClimbing = PreviousMovementMode == EMovementMode::MOVE_Custom && PreviousCustomMode == CMOVE_Climbing;
+	UClimbingSubsystem* Subsystem = GetWorld()->GetSubsystem<UClimbingSubsystem>();
+	if (Subsystem && IsClimbing() && !bWasClimbing && CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
+	{
+		Subsystem->RegisterClimber(this);
+	}
+
+	// The fixed steps start over on every wall
+	if (IsClimbing() && !bWasClimbing)
+	{
+		ClimbingStepAccumulator = 0.f;
+		PreviousStepLocation = UpdatedComponent->GetComponentLocation();
+		PreviousStepRotation = UpdatedComponent->GetComponentQuat();
+	}
+
+	// Pending probes belong to the wall that was just left
+	if (bWasClimbing && !IsClimbing())
+	{
+		if (Subsystem)
+		{
+			Subsystem->UnregisterClimber(this);
+		}
+
+		bWantsVaultProbe = false;
+		bHasWallSurface = false;
+		WallSurfaceBase.Reset();
+		bHasBatchSolve = false;
+		WallComponent.Reset();
+		ProbeBatch.Reset();
+		SurfaceCache.Reset();
+		LedgeDetector.Reset();
+		ClimbingStepAccumulator = 0.f;
+		ResetClimbingStepVisuals();
+		LandscapeSampler.Reset();
+		bLandscapeSamplingSuspended = false;
+	}
+
+	// The edge is scanned again on the next grab, the ledge may have moved since
+	const bool bWasHanging = PreviousMovementMode == EMovementMode::MOVE_Custom && PreviousCustomMode == CMOVE_Hanging;
+	if (bWasHanging && !IsHanging())
+	{
+		LedgeEdge.Reset();
+		bHangClimbUpTried = false;
+	}
+
+	// The jump up the wall ended without reaching the apex
+	if (IsMovingOnGround())
+	{
+		bReattachAtApex = false;
+		WallJumpOutcome = EClimbingWallJumpOutcome::Pending;
+		WallJumpPredictor.Reset();
+	}
+}
+
+FVector UClimbingMovementComponent::ConstrainInputAcceleration(const FVector& InputAcceleration) const
+{
+	// While climbing, the vertical input is what moves the character up and down the wall
+	if (IsClimbing() || IsHanging())
+	{
+		return InputAcceleration;
+	}
+	return Super::ConstrainInputAcceleration(InputAcceleration);
+}
+
+void UClimbingMovementComponent::PhysClimbing(float deltaTime, int32 Iterations)
+{
+	if (deltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	// One step per frame, also with fixed steps while the root motion prepared for the whole frame moves to or off the wall
+	if (!bFixedStepClimbing || CurrentRootMotion.HasOverrideVelocity())
+	{
+		ClimbingStepAccumulator = 0.f;
+		PreviousStepLocation = UpdatedComponent->GetComponentLocation();
+		PreviousStepRotation = UpdatedComponent->GetComponentQuat();
+		ClimbingStep(deltaTime, Iterations);
+		return;
+	}
+
+	const float StepTime = GetClimbingStepTime();
+	ClimbingStepAccumulator += deltaTime;
+
+	int32 NumSteps = 0;
+	while (ClimbingStepAccumulator >= StepTime && IsClimbing())
+	{
+		if (NumSteps == MaxClimbingStepsPerFrame)
+		{
+			ClimbingStepAccumulator = FMath::Fmod(ClimbingStepAccumulator, StepTime);
+			break;
+		}
+
+		PreviousStepLocation = UpdatedComponent->GetComponentLocation();
+		PreviousStepRotation = UpdatedComponent->GetComponentQuat();
+		ClimbingStepAccumulator -= StepTime;
+		++NumSteps;
+
+		// A step that vaults or detaches goes on with the new movement mode for its own time, the rest of the frame is dropped
+		ClimbingStep(StepTime, Iterations);
+	}
+}
+
+void UClimbingMovementComponent::ClimbingStep(float deltaTime, int32 Iterations)
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingPhys);
+
+	// Both axes are solved together, so the result does not depend on the order of the input
+	const FVector2D ClimbInput = GetClimbInput();
+	FVector MoveDirection = FVector::ZeroVector;
+	bool bCanMove = false;
+
+	// The rotation is derived from the wall on every machine instead of being replicated
+	FVector WallLocation, WallNormal;
+	FRotator TargetRotation = GetWallSurface(WallLocation, WallNormal) ?
+		(-WallNormal).Rotation() : UpdatedComponent->GetComponentRotation();
+
+	// The move to the wall on attach is driven by root motion, input is ignored until it ends
+	const bool bRootMotionOverride = CurrentRootMotion.HasOverrideVelocity();
+
+	if (!ClimbInput.IsNearlyZero() && !bRootMotionOverride)
+	{
+		bCanMove = SolveClimbSurface(ClimbInput, MoveDirection, TargetRotation);
+
+		// The character vaulted or detached from the wall
+		if (!IsClimbing())
+		{
+			StartNewPhysics(deltaTime, Iterations);
+			return;
+		}
+	}
+
+	// The surface solved may be on another wall, which then carries the character
+	UpdateClimbingBase();
+
+	if (bCanMove)
+	{
+		// Accelerate along the wall, the input acceleration is kept for the next probes
+		const FVector InputAcceleration = Acceleration;
+		Acceleration = MoveDirection * FMath::Min(ClimbInput.Size(), 1.f) * GetMaxAcceleration();
+		CalcVelocity(deltaTime, 0.f, false, GetMaxBrakingDeceleration());
+		Acceleration = InputAcceleration;
+	}
+	else if (ClimbInput.IsNearlyZero())
+	{
+		// No input, brake on the wall
+		CalcVelocity(deltaTime, 0.f, false, GetMaxBrakingDeceleration());
+	}
+	else
+	{
+		// The wall in the direction of the input can't be climbed
+		Velocity = FVector::ZeroVector;
+	}
+
+	ApplyRootMotionToVelocity(deltaTime);
+
+	Iterations++;
+	bJustTeleported = false;
+
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	const FVector Delta = Velocity * deltaTime;
+	const FRotator NewRotation = FClimbingSolver::InterpRotation(
+		UpdatedComponent->GetComponentRotation(), TargetRotation, deltaTime, ClimbRotationInterpSpeed);
+
+	// Single move for movement and rotation
+	FHitResult Hit(1.f);
+	SafeMoveUpdatedComponent(Delta, NewRotation, true, Hit);
+
+	if (Hit.Time < 1.f)
+	{
+		if (Hit.GetComponent() != GetSampledLandscape())
+		{
+			bLandscapeSamplingSuspended = true;
+		}
+		HandleImpact(Hit, deltaTime, Delta);
+		SlideAlongSurface(Delta, (1.f - Hit.Time), Hit.Normal, Hit, true);
+	}
+
+	if (!bJustTeleported && !HasAnimRootMotion())
+	{
+		Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
+	}
+}
+
+void UClimbingMovementComponent::PhysHanging(float deltaTime, int32 Iterations)
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingHang);
+
+	if (deltaTime < MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	// The ledge went away with its component
+	if (!LedgeEdge.IsValid())
+	{
+		DetachFromWall();
+		StartNewPhysics(deltaTime, Iterations);
+		return;
+	}
+
+	const FVector2D HangInput = GetClimbInput();
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	FRotator NewRotation = UpdatedComponent->GetComponentRotation();
+
+	// The move under the ledge is driven by root motion, input is ignored until it ends
+	if (CurrentRootMotion.HasOverrideVelocity())
+	{
+		ApplyRootMotionToVelocity(deltaTime);
+	}
+	else
+	{
+		float Distance = LedgeEdge.Project(OldLocation);
+
+		if (HangInput.Y <= 0.5f)
+		{
+			bHangClimbUpTried = false;
+		}
+		else if (!bHangClimbUpTried)
+		{
+			bHangClimbUpTried = true;
+			if (TryClimbUpFromHang(LedgeEdge.Evaluate(Distance)))
+			{
+				StartNewPhysics(deltaTime, Iterations);
+				return;
+			}
+		}
+
+		if (HangInput.Y < -0.5f)
+		{
+			// Back on the wall under the ledge, the climbing probes take over from here
+			const FClimbingLedgePoint Point = LedgeEdge.Evaluate(Distance);
+			UPrimitiveComponent* LedgeComponent = LedgeEdge.GetComponent();
+			SetMovementMode(EMovementMode::MOVE_Custom, CMOVE_Climbing);
+			SetWallSurface(Point.Location - FVector::UpVector * HangVerticalOffset, Point.Normal, LedgeComponent);
+			WallComponent = LedgeComponent;
+			UpdateClimbingBase();
+			StartNewPhysics(deltaTime, Iterations);
+			return;
+		}
+
+		// Queries are only issued while the character shimmies towards an end of the edge that was not scanned past,
+		// a few points per frame until the edge is known for LedgeScanDistance ahead or the ledge ends
+		const float Step = FMath::Clamp(HangInput.X, -1.f, 1.f) * HangShimmySpeed * deltaTime;
+		const bool bTowardsEnd = Step > 0.f;
+		if (Step != 0.f && LedgeEdge.IsEndOpen(bTowardsEnd))
+		{
+			const float DistanceToEnd = bTowardsEnd ? LedgeEdge.GetLength() - Distance : Distance;
+			if (DistanceToEnd - FMath::Abs(Step) <= FMath::Max(LedgeScanDistance, LedgeScanSpacing))
+			{
+				ScanLedgeEdge(bTowardsEnd, LedgeScanSamplesPerFrame);
+				Distance = LedgeEdge.Project(OldLocation);
+			}
+		}
+
+		const FClimbingLedgePoint Target = LedgeEdge.Evaluate(FMath::Clamp(Distance + Step, 0.f, LedgeEdge.GetLength()));
+		Velocity = (GetHangLocation(Target) - OldLocation) / deltaTime;
+
+		const FRotator TargetRotation(0.f, (-Target.Normal).Rotation().Yaw, 0.f);
+		NewRotation = FClimbingSolver::InterpRotation(NewRotation, TargetRotation, deltaTime, ClimbRotationInterpSpeed);
+	}
+
+	Iterations++;
+	bJustTeleported = false;
+
+	const FVector Delta = Velocity * deltaTime;
+	FHitResult Hit(1.f);
+	SafeMoveUpdatedComponent(Delta, NewRotation, true, Hit);
+
+	// Something stands on the edge, the character stops against it
+	if (Hit.Time < 1.f)
+	{
+		HandleImpact(Hit, deltaTime, Delta);
+	}
+
+	if (!bJustTeleported && !HasAnimRootMotion())
+	{
+		Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
+	}
+}
+
+float UClimbingMovementComponent::GetClimbingStepTime() const
+{
+	return 1.f / FMath::Max(ClimbingStepRate, 1.f);
+}
+
+bool UClimbingMovementComponent::IsClimbingStepDue(float DeltaTime) const
+{
+	return !bFixedStepClimbing || ClimbingStepAccumulator + DeltaTime >= GetClimbingStepTime();
+}
+
+void UClimbingMovementComponent::UpdateClimbingStepVisuals()
+{
+	USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr;
+	if (!Mesh || !UpdatedComponent || IsNetMode(NM_DedicatedServer))
+	{
+		return;
+	}
+
+	// Remote clients of a listen server are already smoothed by the character movement
+	if (!bFixedStepClimbing || !IsClimbing() || CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy ||
+	    (CharacterOwner->GetLocalRole() == ROLE_Authority && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy))
+	{
+		ResetClimbingStepVisuals();
+		return;
+	}
+
+	const float Alpha = FMath::Clamp(ClimbingStepAccumulator / GetClimbingStepTime(), 0.f, 1.f);
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const FQuat Rotation = UpdatedComponent->GetComponentQuat();
+	const FVector VisualLocation = FMath::Lerp(PreviousStepLocation, Location, Alpha);
+	const FQuat VisualRotation = FQuat::Slerp(PreviousStepRotation, Rotation, Alpha);
+
+	// Offsets from the capsule in its own space, on top of the offsets the mesh was placed with
+	Mesh->SetRelativeLocationAndRotation(
+		Rotation.UnrotateVector(VisualLocation - Location) + CharacterOwner->GetBaseTranslationOffset(),
+		Rotation.Inverse() * VisualRotation * CharacterOwner->GetBaseRotationOffset());
+	bClimbingStepVisuals = true;
+}
+
+void UClimbingMovementComponent::ResetClimbingStepVisuals()
+{
+	if (!bClimbingStepVisuals)
+	{
+		return;
+	}
+
+	bClimbingStepVisuals = false;
+	if (USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr)
+	{
+		Mesh->SetRelativeLocationAndRotation(CharacterOwner->GetBaseTranslationOffset(), CharacterOwner->GetBaseRotationOffset());
+	}
+}
+
+FVector2D UClimbingMovementComponent::GetClimbInput() const
+{
+	const float MaxAccel = GetMaxAcceleration();
+	if (MaxAccel <= 0.f)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const FVector Input = Acceleration / MaxAccel;
+	return FVector2D(FVector::DotProduct(Input, UpdatedComponent->GetRightVector()),
+	                 FVector::DotProduct(Input, UpdatedComponent->GetUpVector()));
+}
+
+bool UClimbingMovementComponent::SolveClimbSurface(const FVector2D& ClimbInput, FVector& OutDirection, FRotator& OutRotation)
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingSolve);
+
+	FClimbingSolveOutput Solve;
+
+	// The batch solved the pose of the first step of this frame with the input of last frame, it still holds
+	// if the character did not move since and the input did not change. Replayed and server moves never match
+	if (bHasBatchSolve && !Recorder && FVector2D::DistSquared(BatchSolveInput, ClimbInput) <= FMath::Square(0.05f) &&
+	    BatchSolveLocation.Equals(UpdatedComponent->GetComponentLocation(), 0.1f))
+	{
+		Solve = BatchSolve;
+	}
+	else
+	{
+		FClimbingSolveInput Input;
+		ResolveClimbProbes(ClimbInput, Input);
+		FClimbingSolver::Solve(GetSolverSettings(), Input, Solve);
+
+		if (Recorder)
+		{
+			FClimbingRecordedSolve Recorded;
+			Recorded.ClimbInput = ClimbInput;
+			Recorded.Location = Input.Location;
+			Recorded.CapsuleRadius = Input.CapsuleRadius;
+			Recorded.bAheadHit = Input.bAheadHit;
+			Recorded.AheadLocation = Input.AheadLocation;
+			Recorded.AheadNormal = Input.AheadNormal;
+			Recorded.bAheadClimbable = Input.AheadRules.bClimbable;
+			Recorded.AheadMinClimbAngle = Input.AheadRules.MinClimbAngle;
+			Recorded.AheadMaxClimbAngle = Input.AheadRules.MaxClimbAngle;
+			Recorded.WallNormal = Input.WallNormal;
+			Recorded.Status = static_cast<uint8>(Solve.Status);
+			Recorded.Direction = Solve.Direction;
+			Recorded.Rotation = Solve.Status == EClimbingSolveStatus::Move ? Solve.Rotation : FRotator::ZeroRotator;
+			Recorder->RecordSolve(Recorded);
+		}
+	}
+	bHasBatchSolve = false;
+
+	if (!ApplyClimbSolve(Solve.Status, ClimbInput, Solve.Rotation))
+	{
+		return false;
+	}
+
+	OutDirection = Solve.Direction;
+	OutRotation = Solve.Rotation;
+	return true;
+}
+
+void UClimbingMovementComponent::ResolveClimbProbes(const FVector2D& ClimbInput, FClimbingSolveInput& OutInput)
+{
+	OutInput.Location = UpdatedComponent->GetComponentLocation();
+	OutInput.CapsuleRadius = GetCapsuleRadius();
+
+	// The boxcasts in the direction of the character movement and in front of it
+	// were submitted with last frame's probe batch
+	FVector Start1, End1, Start2, End2;
+	GetAheadProbe(ClimbInput, Start1, End1);
+	GetWallProbe(Start2, End2);
+
+	FHitResult OutHit1, OutHit2;
+	OutInput.bAheadHit = GetProbeHit(EClimbingProbe::Ahead, Start1, End1, OutHit1);
+	OutInput.AheadLocation = OutHit1.Location;
+	OutInput.AheadNormal = OutHit1.Normal;
+	OutInput.AheadRules = GetSurfaceRules(OutHit1);
+
+	// The orientation of the wall comes from the plane fitted through the probe pattern, when it was traced. The
+	// cache keeps the fitted plane, so the frames it answers solve with the same normal as the frame that traced it
+	FClimbingPlaneFitResult Fit;
+	const bool bFitted = OutInput.bAheadHit && FitProbePattern(OutHit1, Fit);
+	if (bFitted)
+	{
+		ProjectOnFittedPlane(Fit, OutHit1);
+		OutInput.AheadLocation = OutHit1.Location;
+		OutInput.AheadNormal = OutHit1.Normal;
+		SurfaceCache.Store(EClimbingProbe::Ahead, OutHit1);
+	}
+
+	OutInput.WallNormal = FVector::ZeroVector;
+	if (GetProbeHit(EClimbingProbe::Wall, Start2, End2, OutHit2))
+	{
+		// The wall in front of the character on the fitted plane takes its normal as well, in the wall surface and in
+		// the cache when it was traced for this frame
+		if (bFitted && OutHit2.GetComponent() == OutHit1.GetComponent() &&
+		    FMath::Abs(FVector::DotProduct(OutHit2.Location - Fit.Point, Fit.Normal)) <= SurfaceFitOutlierDistance)
+		{
+			ProjectOnFittedPlane(Fit, OutHit2);
+			if (ProbeBatch.GetResult(EClimbingProbe::Wall).bValid)
+			{
+				SurfaceCache.Store(EClimbingProbe::Wall, OutHit2);
+			}
+		}
+
+		UpdateWallSurface(OutHit2);
+		OutInput.WallNormal = OutHit2.Normal;
+	}
+}
+
+void UClimbingMovementComponent::ProjectOnFittedPlane(const FClimbingPlaneFitResult& Fit, FHitResult& InOutHit)
+{
+	const FVector Offset = Fit.Normal * FVector::DotProduct(InOutHit.Location - Fit.Point, Fit.Normal);
+	InOutHit.Location -= Offset;
+	InOutHit.ImpactPoint -= Offset;
+	InOutHit.Normal = Fit.Normal;
+	InOutHit.ImpactNormal = Fit.Normal;
+}
+
+bool UClimbingMovementComponent::ApplyClimbSolve(EClimbingSolveStatus Status, const FVector2D& ClimbInput, const FRotator& Rotation)
+{
+	switch (Status)
+	{
+	case EClimbingSolveStatus::Move:
+		bClimbing = true;
+		return true;
+
+	case EClimbingSolveStatus::NoWall:
+		UE_LOG_CLIMBING_THROTTLED(Verbose, TEXT("Wall not found!"));
+		TryVault(ClimbInput);
+		return false;
+
+	case EClimbingSolveStatus::InvalidClimbAngle:
+		UE_LOG_CLIMBING_THROTTLED(Log, TEXT("Climb Angle Invalid: %f"), Rotation.Pitch);
+		return false;
+
+	case EClimbingSolveStatus::NotClimbable:
+		UE_LOG_CLIMBING_THROTTLED(Verbose, TEXT("Wall not climbable"));
+		return false;
+
+	case EClimbingSolveStatus::TurnTooSharp:
+		UE_LOG_CLIMBING_THROTTLED(Verbose, TEXT("Turn too sharp"));
+		return false;
+	}
+
+	return false;
+}
+
+void UClimbingMovementComponent::SetBatchSolve(const FVector2D& ClimbInput, const FVector& Location, const FClimbingSolveOutput& Solve)
+{
+	bHasBatchSolve = true;
+	BatchSolveInput = ClimbInput;
+	BatchSolveLocation = Location;
+	BatchSolve = Solve;
+}
+
+void UClimbingMovementComponent::TryVault(const FVector2D& ClimbInput)
+{
+	// Vault?
+	// Check if the character can vault up
+	// Is the input upwards relative to character?
+	if (!FClimbingSolver::IsVaultInput(ClimbInput) || !bClimbing)
+	{
+		return;
+	}
+
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingVaultCheck);
+
+	// The ledge detector found this edge while the character was climbing towards it
+	bool bCanVault = false;
+	FVector LedgeVaultLocation;
+	if (LedgeDetector.FindVault(GetLedgeFrame(), bCanVault, LedgeVaultLocation))
+	{
+		if (!bCanVault)
+		{
+			UE_LOG_CLIMBING_THROTTLED(Log, TEXT("Can't vault"));
+			TryHang();
+			return;
+		}
+
+		INC_DWORD_STAT(STAT_ClimbingLedgeLookaheadVaults);
+		VaultUp(LedgeVaultLocation);
+		return;
+	}
+
+	const FVector Forward = UpdatedComponent->GetForwardVector();
+	// Location is is basically the position that has been checked to be free plus a small offset forward
+	const FVector Location = GetVaultProbeLocation() + Forward*30.f + GetCapsuleRadius() * -2.f * Forward;
+
+	// The clearance above a baked ledge was checked offline, no need to cast the capsule
+	const UClimbableSurfaceIndex* SurfaceIndex = GetSurfaceIndex();
+	FVector WallLocation, WallNormal;
+	if (SurfaceIndex && GetWallSurface(WallLocation, WallNormal) &&
+	    SurfaceIndex->HasLedgeAbove(WallLocation, GetCapsuleHalfHeight() + SurfaceIndex->CellSize, GetCapsuleRadius(), GetCapsuleHalfHeight()))
+	{
+		INC_DWORD_STAT(STAT_ClimbingIndexHits);
+		VaultUp(Location);
+		return;
+	}
+
+	// If this capsule cast with the size of the character, does not find anything above it, the character will climb on top
+	const FClimbingProbeResult& VaultResult = ProbeBatch.GetResult(EClimbingProbe::Vault);
+	if (!VaultResult.bValid)
+	{
+		// The capsule cast goes out with the next batch, the vault is decided when it comes back
+		bWantsVaultProbe = true;
+		return;
+	}
+
+	if (VaultResult.bHit)
+	{
+		UE_LOG_CLIMBING_THROTTLED(Log, TEXT("Can't vault"));
+		TryHang();
+		return;
+	}
+
+	VaultUp(Location);
+}
+
+void UClimbingMovementComponent::VaultUp(const FVector& Location)
+{
+	DetachFromWall();
+
+	// Move the character up, the upward root motion lifts it off the ground
+	ApplyClimbingMove(EClimbingTransition::Vault, Location);
+}
+
+bool UClimbingMovementComponent::TryHang()
+{
+	FVector WallLocation, WallNormal;
+	if (!bLedgeHang || !GetWallSurface(WallLocation, WallNormal))
+	{
+		return false;
+	}
+
+	WallNormal = WallNormal.GetSafeNormal2D();
+	if (WallNormal.IsNearlyZero())
+	{
+		return false;
+	}
+
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingLedgeScan);
+
+	// The edge is above the character, below the probe ahead that went past the wall
+	FHitResult WallHit;
+	FClimbingLedgePoint Point;
+	if (!ScanLedgePoint(UpdatedComponent->GetComponentLocation() - WallNormal * GetCapsuleRadius(), WallNormal, WallHit, Point))
+	{
+		return false;
+	}
+
+	// Only the point grabbed is traced now, the edge is scanned from it on the way when the character shimmies
+	LedgeEdge.Start(WallHit.GetComponent(), Point);
+
+	SetMovementMode(EMovementMode::MOVE_Custom, CMOVE_Hanging);
+	StopMovementImmediately();
+	bOrientRotationToMovement = false;
+	SetBase(LedgeEdge.GetComponent());
+
+	// The up input that brought the character here does not climb on top right away
+	bHangClimbUpTried = true;
+
+	ApplyClimbingMove(EClimbingTransition::Hang, GetHangLocation(Point));
+	return true;
+}
+
+bool UClimbingMovementComponent::ScanLedgePoint(const FVector& Guess, const FVector& WallNormal, FHitResult& OutWallHit, FClimbingLedgePoint& OutPoint) const
+{
+	// Down on top of the wall, just behind its face
+	const FVector Inside = Guess - WallNormal * 10.f;
+	const FVector Reach = FVector::UpVector * GetCapsuleHalfHeight();
+	FHitResult TopHit;
+	if (!WallTrace(TopHit, Inside + Reach, Inside - Reach, FColor::Orange) || TopHit.bStartPenetrating ||
+	    TopHit.ImpactNormal.Z < GetWalkableFloorZ())
+	{
+		return false;
+	}
+
+	// Against the face of the wall, just under the top
+	const FVector Face(Guess.X, Guess.Y, TopHit.ImpactPoint.Z - 10.f);
+	if (!WallTrace(OutWallHit, Face + WallNormal * GetCapsuleRadius() * 2.f, Face - WallNormal * GetCapsuleRadius(), FColor::Orange) ||
+	    OutWallHit.bStartPenetrating || !GetSurfaceRules(OutWallHit).bClimbable)
+	{
+		return false;
+	}
+
+	OutPoint.Normal = OutWallHit.ImpactNormal.GetSafeNormal2D();
+	OutPoint.Location = FVector(OutWallHit.ImpactPoint.X, OutWallHit.ImpactPoint.Y, TopHit.ImpactPoint.Z);
+	return !OutPoint.Normal.IsNearlyZero();
+}
+
+void UClimbingMovementComponent::ScanLedgeEdge(bool bAtEnd, int32 MaxSamples)
+{
+	if (!LedgeEdge.IsValid() || !LedgeEdge.IsEndOpen(bAtEnd))
+	{
+		return;
+	}
+
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingLedgeScan);
+
+	const float Spacing = FMath::Max(LedgeScanSpacing, 1.f);
+	const int32 NumSamples = FMath::Max(MaxSamples, 1);
+	FClimbingLedgePoint Last = LedgeEdge.GetEndPoint(bAtEnd);
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		// The end of the edge is on the right of a character facing the wall
+		const FVector Along = FVector::CrossProduct(FVector::UpVector, -Last.Normal) * (bAtEnd ? 1.f : -1.f);
+
+		// The edge is kept in the space of its component, it stops where the wall does, turns too much or goes on another component
+		FHitResult WallHit;
+		FClimbingLedgePoint Point;
+		if (!ScanLedgePoint(Last.Location + Along * Spacing, Last.Normal, WallHit, Point) ||
+		    WallHit.GetComponent() != LedgeEdge.GetComponent() ||
+		    FClimbingSolver::GetTurnAngle(Last.Normal, Point.Normal) > MaxTurnAngle)
+		{
+			LedgeEdge.CloseEnd(bAtEnd);
+			return;
+		}
+
+		LedgeEdge.AddPoint(bAtEnd, Point);
+		Last = Point;
+	}
+}
+
+FVector UClimbingMovementComponent::GetHangLocation(const FClimbingLedgePoint& Point) const
+{
+	return Point.Location + Point.Normal * GetCapsuleRadius() - FVector::UpVector * HangVerticalOffset;
+}
+
+bool UClimbingMovementComponent::TryClimbUpFromHang(const FClimbingLedgePoint& Point)
+{
+	// On top of the ledge, far enough from the edge for the whole capsule
+	const FVector TopLocation = Point.Location - Point.Normal * GetCapsuleRadius() * 2.f + FVector::UpVector * (GetCapsuleHalfHeight() + 2.f);
+	CLIMBING_COUNT_SWEEPS(1);
+
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbingHangClimbUp), false, CharacterOwner);
+	if (GetWorld()->OverlapBlockingTestByChannel(TopLocation, FQuat::Identity, ECC_Climbable,
+	                                             FCollisionShape::MakeCapsule(GetCapsuleRadius(), GetCapsuleHalfHeight()), Params))
+	{
+		UE_LOG_CLIMBING_THROTTLED(Log, TEXT("Can't climb on top of the ledge"));
+		return false;
+	}
+
+	VaultUp(TopLocation);
+	return true;
+}
+
+void UClimbingMovementComponent::WallJump()
+{
+	// Gravity takes over during the jump, the wall is grabbed again at the apex
+	const FVector JumpVelocity = UpdatedComponent->GetUpVector() * WallJumpVelocity;
+	bClimbing = false;
+	bWantsToClimb = false;
+	SetMovementMode(EMovementMode::MOVE_Falling);
+	Launch(JumpVelocity);
+
+	bNotifyApex = true;
+	bReattachAtApex = true;
+	WallJumpOutcome = EClimbingWallJumpOutcome::Pending;
+
+	// The apex is probed while the character goes up. Replayed moves keep the probes of the original jump,
+	// the outcome they decided comes back with the saved moves
+	if (!CharacterOwner->bClientUpdating)
+	{
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbingWallJump), false, CharacterOwner);
+		Params.bReturnPhysicalMaterial = true;
+		WallJumpPredictor.Start(GetWorld(), GetWallJumpFrame(JumpVelocity), ECC_Climbable, Params);
+	}
+}
+
+FClimbingWallJumpFrame UClimbingMovementComponent::GetWallJumpFrame(const FVector& JumpVelocity) const
+{
+	FClimbingWallJumpFrame Frame;
+	Frame.Location = UpdatedComponent->GetComponentLocation();
+	Frame.Velocity = JumpVelocity;
+	Frame.Gravity = FVector(0.f, 0.f, GetGravityZ());
+	Frame.Forward = UpdatedComponent->GetForwardVector();
+	Frame.CapsuleRadius = GetCapsuleRadius();
+	Frame.CapsuleHalfHeight = GetCapsuleHalfHeight();
+	return Frame;
+}
+
+void UClimbingMovementComponent::UpdateWallJumpPrediction()
+{
+	// Decided in the last move. The saved move carries the decision, so the server and the replays apply it
+	// in this same move whenever their own probes come back
+	if (WallJumpOutcome == EClimbingWallJumpOutcome::Vault || WallJumpOutcome == EClimbingWallJumpOutcome::Drop)
+	{
+		ApplyWallJumpOutcome();
+		return;
+	}
+
+	const EClimbingWallJumpOutcome Outcome = WallJumpPredictor.Update(GetWorld(), GetWallJumpFrame(Velocity), GetWalkableFloorZ(),
+		[this](const FHitResult& Hit) { return GetSurfaceRules(Hit).bClimbable; });
+
+	// The server follows the client, its own probes only check what the client decided
+	const bool bFollowsClient = CharacterOwner->GetLocalRole() == ROLE_Authority && !CharacterOwner->IsLocallyControlled();
+	if (bFollowsClient || WallJumpOutcome != EClimbingWallJumpOutcome::Pending)
+	{
+		return;
+	}
+
+	WallJumpOutcome = Outcome;
+	if (Outcome == EClimbingWallJumpOutcome::Vault)
+	{
+		WallJumpVaultLocation = WallJumpPredictor.GetVaultLocation();
+	}
+}
+
+void UClimbingMovementComponent::AcceptClientWallJumpOutcome(EClimbingWallJumpOutcome ClientOutcome, const FVector& ClientVaultLocation)
+{
+	if (!bReattachAtApex || WallJumpOutcome != EClimbingWallJumpOutcome::Pending || ClientOutcome == EClimbingWallJumpOutcome::Pending)
+	{
+		return;
+	}
+
+	// Probes of the server that came back win, a client that decided otherwise is corrected
+	const EClimbingWallJumpOutcome ServerOutcome = WallJumpPredictor.GetOutcome();
+	if (ServerOutcome != EClimbingWallJumpOutcome::Pending)
+	{
+		WallJumpOutcome = ServerOutcome;
+		WallJumpVaultLocation = WallJumpPredictor.GetVaultLocation();
+		return;
+	}
+
+	// Otherwise the vault has to land where the probe down on top of the wall would have
+	if (ClientOutcome == EClimbingWallJumpOutcome::Vault && !WallJumpPredictor.IsOnLedgeProbe(ClientVaultLocation, GetCapsuleRadius()))
+	{
+		return;
+	}
+
+	WallJumpOutcome = ClientOutcome;
+	WallJumpVaultLocation = ClientVaultLocation;
+}
+
+void UClimbingMovementComponent::ApplyWallJumpOutcome()
+{
+	const EClimbingWallJumpOutcome Outcome = WallJumpOutcome;
+	bReattachAtApex = false;
+	WallJumpOutcome = EClimbingWallJumpOutcome::Pending;
+	WallJumpPredictor.Reset();
+
+	if (Outcome == EClimbingWallJumpOutcome::Vault)
+	{
+		// The wall ends below the apex, go on top of it instead of grabbing the air
+		VaultUp(WallJumpVaultLocation);
+	}
+	else if (Outcome == EClimbingWallJumpOutcome::Drop)
+	{
+		UE_LOG_CLIMBING_THROTTLED(Log, TEXT("No wall at the apex of the wall jump"));
+		DetachFromWall();
+	}
+}
+
+void UClimbingMovementComponent::ApplyClimbingMove(EClimbingTransition Transition, const FVector& Location)
+{
+	TSharedPtr<FRootMotionSource_MoveToDynamicForce>& MovePtr = TransitionMoves[static_cast<int32>(Transition)];
+
+	// Still referenced when the same transition restarts before the movement dropped the last one
+	if (!MovePtr.IsUnique())
+	{
+		MovePtr = MakeShared<FRootMotionSource_MoveToDynamicForce>();
+	}
+
+	// Back to a fresh source, the status, time and ID of the last move are not carried over
+	FRootMotionSource_MoveToDynamicForce& Move = *MovePtr;
+	Move = FRootMotionSource_MoveToDynamicForce();
+
+	const bool bVault = Transition == EClimbingTransition::Vault;
+	Move.InstanceName = ClimbingMovement::GetMoveName(Transition);
+	Move.AccumulateMode = ERootMotionAccumulateMode::Override;
+	Move.Priority = 500;
+	Move.StartLocation = UpdatedComponent->GetComponentLocation();
+	Move.InitialTargetLocation = Location;
+	Move.TargetLocation = Location;
+	Move.Duration = FMath::Max(bVault ? VaultDuration : AttachDuration, MIN_TICK_TIME);
+	Move.bRestrictSpeedToExpected = true;
+	Move.TimeMappingCurve = bVault ? VaultTimeCurve : AttachTimeCurve;
+	Move.PathOffsetCurve = bVault ? VaultPathCurve : nullptr;
+
+	// The character stops where the move ends
+	Move.FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::SetVelocity;
+	Move.FinishVelocityParams.SetVelocity = FVector::ZeroVector;
+
+	ApplyRootMotionSource(MovePtr);
+}
+
+void UClimbingMovementComponent::CancelAttachMoves()
+{
+	// A vault starts by detaching from the wall, it is never cancelled here
+	RemoveRootMotionSource(ClimbingMovement::GetMoveName(EClimbingTransition::Attach));
+	RemoveRootMotionSource(ClimbingMovement::GetMoveName(EClimbingTransition::Reattach));
+}
+
+bool UClimbingMovementComponent::WallTrace(FHitResult& OutHit, FVector Start, FVector End, FColor Color) const
+{
+	ClimbingDebug::DrawProbe(GetWorld(), Start, End, Color);
+	CLIMBING_COUNT_SWEEPS(1);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbingWallTrace), false, CharacterOwner);
+	Params.bReturnPhysicalMaterial = true;
+	return GetWorld()->SweepSingleByChannel(
+		OutHit, Start, End,
+		FQuat::Identity, ECC_Climbable,
+		FCollisionShape::MakeBox(FVector(0.01f, 0.01f, 0.01f)),
+		Params);
+}
+
+FClimbingSurfaceRules UClimbingMovementComponent::GetSurfaceRules(const FHitResult& Hit) const
+{
+	FClimbingSurfaceRules Rules;
+	Rules.MinClimbAngle = MinClimbAngle;
+	Rules.MaxClimbAngle = MaxClimbAngle;
+
+	if (const UClimbablePhysicalMaterial* Material = Cast<UClimbablePhysicalMaterial>(Hit.PhysMaterial.Get()))
+	{
+		Material->ApplyTo(Rules);
+	}
+	return Rules;
+}
+
+void UClimbingMovementComponent::ResetRotation()
+{
+	// Need to add a gradual interpolation, with a timer or something like that
+	const FRotator Rotation = UpdatedComponent->GetComponentRotation();
+	MoveUpdatedComponent(FVector::ZeroVector, FRotator{0.f, Rotation.Yaw, Rotation.Roll}, false);
+}
+
+void UClimbingMovementComponent::GetAheadProbe(const FVector2D& ClimbInput, FVector& OutStart, FVector& OutEnd) const
+{
+	// Offset of half the height when moving vertically and one and a half radius when moving horizontally
+	const FVector Offset =
+		UpdatedComponent->GetUpVector() * ClimbInput.Y * GetCapsuleHalfHeight() +
+		UpdatedComponent->GetRightVector() * ClimbInput.X * GetCapsuleRadius() * 1.5f;
+	OutStart = Offset + UpdatedComponent->GetComponentLocation();
+	OutEnd = OutStart + (GetCapsuleRadius() * 2 * UpdatedComponent->GetForwardVector());
+}
+
+void UClimbingMovementComponent::GetWallProbe(FVector& OutStart, FVector& OutEnd) const
+{
+	const float RayLength = 80.f;
+	OutStart = UpdatedComponent->GetComponentLocation();
+	OutEnd = OutStart + RayLength * UpdatedComponent->GetForwardVector();
+}
+
+FVector UClimbingMovementComponent::GetVaultProbeLocation() const
+{
+	return UpdatedComponent->GetUpVector() * (GetCapsuleHalfHeight()*2.f) + UpdatedComponent->GetComponentLocation()
+		+ UpdatedComponent->GetForwardVector()*GetCapsuleRadius()*2.f;
+}
+
+void UClimbingMovementComponent::AddProbePattern(const FVector& Start, const FVector& End, const FCollisionShape& Shape)
+{
+	const int32 GridSize = GetSurfaceProbeGridSize();
+	if (GridSize <= 1)
+	{
+		return;
+	}
+
+	// A grid across the capsule footprint, centered on the probe ahead which stands for the middle cell
+	const FVector Right = UpdatedComponent->GetRightVector() * GetCapsuleRadius() * SurfaceProbeSpacing;
+	const FVector Up = UpdatedComponent->GetUpVector() * GetCapsuleHalfHeight() * SurfaceProbeSpacing;
+	const float Center = (GridSize - 1) * 0.5f;
+	for (int32 Row = 0; Row < GridSize; ++Row)
+	{
+		for (int32 Column = 0; Column < GridSize; ++Column)
+		{
+			const FVector Offset = Right * (Column - Center) + Up * (Row - Center);
+			if (Offset.IsNearlyZero())
+			{
+				continue;
+			}
+
+			ClimbingDebug::DrawProbe(GetWorld(), Start + Offset, End + Offset, FColor::Cyan);
+			ProbeBatch.AddPatternSweep(Row * GridSize + Column, Start + Offset, End + Offset, Shape);
+		}
+	}
+}
+
+bool UClimbingMovementComponent::FitProbePattern(const FHitResult& AheadHit, FClimbingPlaneFitResult& OutFit) const
+{
+	const int32 NumPatternProbes = FMath::Square(GetSurfaceProbeGridSize());
+	if (NumPatternProbes <= 1)
+	{
+		return false;
+	}
+
+	// The hits are moved along with the character, like the probe ahead
+	TArray<FVector, TInlineAllocator<FClimbingPlaneFit::MaxPoints>> Points;
+	Points.Add(AheadHit.ImpactPoint);
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	for (int32 Index = 0; Index < NumPatternProbes && Points.Num() < FClimbingPlaneFit::MaxPoints; ++Index)
+	{
+		const FClimbingProbeResult& Result = ProbeBatch.GetPatternResult(Index);
+		if (Result.bValid && Result.bHit)
+		{
+			Points.Add(Result.Hit.ImpactPoint + Location - Result.Origin);
+		}
+	}
+
+	return FClimbingPlaneFit::Fit(Points, AheadHit.Normal, SurfaceFitOutlierDistance, OutFit);
+}
+
+int32 UClimbingMovementComponent::GetSurfaceProbeGridSize() const
+{
+	// The pattern has as many slots in the probe batch as a 3x3 grid
+	return FMath::Clamp(SurfaceProbeGridSize, 1, 3);
+}
+
+FClimbingLedgeFrame UClimbingMovementComponent::GetLedgeFrame() const
+{
+	FClimbingLedgeFrame Frame;
+	Frame.Location = UpdatedComponent->GetComponentLocation();
+	Frame.Forward = UpdatedComponent->GetForwardVector();
+	Frame.Up = UpdatedComponent->GetUpVector();
+	Frame.CapsuleRadius = GetCapsuleRadius();
+	Frame.CapsuleHalfHeight = GetCapsuleHalfHeight();
+	Frame.Lookahead = LedgeLookaheadDistance;
+	return Frame;
+}
+
+void UClimbingMovementComponent::ConsumeClimbProbes()
+{
+	ProbeBatch.Consume(GetWorld());
+
+	// The probe of the ledge detector submitted last frame came back with this frame's batch
+	const FClimbingProbeResult& LedgeResult = ProbeBatch.GetResult(EClimbingProbe::Ledge);
+	LedgeDetector.OnProbeResult(LedgeResult.bValid, LedgeResult.bHit);
+}
+
+int32 UClimbingMovementComponent::QueueClimbProbes(bool bWithPattern)
+{
+	const FVector2D ClimbInput = GetClimbInput();
+
+	// The landscape samples of the last batch were for where the character was then
+	ProbeBatch.ClearResolved();
+
+	// Without input there is no movement, so nothing to look for
+	if (ClimbInput.IsNearlyZero() && !bWantsVaultProbe) return 0;
+
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingSubmitProbes);
+
+	const FCollisionShape BoxShape = FCollisionShape::MakeBox(FVector(0.01f, 0.01f, 0.01f));
+	FVector Start, End;
+
+	// Probes the surface cache can still serve next frame are not traced. Half the tolerance
+	// is used here, so the cached surface is refreshed before the character moves past it
+	const float CacheDistanceTolerance = SurfaceCacheDistanceTolerance * 0.5f;
+
+	// Probes answered by the baked surfaces or the landscape now will most likely be answered by them next frame as well.
+	// The landscape samples are kept with the batch, the probes read back from the same place reuse them
+	const UClimbableSurfaceIndex* SurfaceIndex = GetSurfaceIndex();
+	ULandscapeHeightfieldCollisionComponent* Landscape = GetSampledLandscape();
+	FHitResult IndexHit;
+
+	if (!ClimbInput.IsNearlyZero())
+	{
+		GetAheadProbe(ClimbInput, Start, End);
+		if (!SampleLandscapeProbe(Landscape, EClimbingProbe::Ahead, Start, End) &&
+		    !SurfaceCache.CanServe(EClimbingProbe::Ahead, Start, End, CacheDistanceTolerance, SurfaceCacheAngleTolerance) &&
+		    !(SurfaceIndex && SurfaceIndex->Raycast(Start, End, false, IndexHit)))
+		{
+			ClimbingDebug::DrawProbe(GetWorld(), Start, End, FColor::Purple);
+			ProbeBatch.AddSweep(EClimbingProbe::Ahead, Start, End, BoxShape);
+			if (bWithPattern)
+			{
+				AddProbePattern(Start, End, BoxShape);
+			}
+		}
+	}
+
+	GetWallProbe(Start, End);
+	if (!SampleLandscapeProbe(Landscape, EClimbingProbe::Wall, Start, End) &&
+	    !SurfaceCache.CanServe(EClimbingProbe::Wall, Start, End, CacheDistanceTolerance, SurfaceCacheAngleTolerance) &&
+	    !(SurfaceIndex && SurfaceIndex->Raycast(Start, End, true, IndexHit)))
+	{
+		ClimbingDebug::DrawProbe(GetWorld(), Start, End, FColor::Red);
+		ProbeBatch.AddSweep(EClimbingProbe::Wall, Start, End, BoxShape);
+	}
+
+	// While climbing up, the top of the wall is looked for ahead of the character
+	FCollisionShape LedgeShape;
+	if (ClimbInput.Y > 0.f && LedgeDetector.GetNextProbe(GetLedgeFrame(), Start, End, LedgeShape))
+	{
+		if (LedgeShape.IsCapsule())
+		{
+			ClimbingDebug::DrawCapsule(GetWorld(), Start, GetCapsuleHalfHeight(), GetCapsuleRadius(), FColor::Orange);
+		}
+		else
+		{
+			ClimbingDebug::DrawProbe(GetWorld(), Start, End, FColor::Orange);
+		}
+		ProbeBatch.AddSweep(EClimbingProbe::Ledge, Start, End, LedgeShape);
+	}
+
+	if (bWantsVaultProbe)
+	{
+		const FVector VaultLocation = GetVaultProbeLocation();
+		ClimbingDebug::DrawCapsule(GetWorld(), VaultLocation, GetCapsuleHalfHeight(), GetCapsuleRadius(), FColor::Emerald);
+		ProbeBatch.AddSweep(EClimbingProbe::Vault, VaultLocation, VaultLocation,
+		                    FCollisionShape::MakeCapsule(GetCapsuleRadius(), GetCapsuleHalfHeight()));
+		bWantsVaultProbe = false;
+	}
+
+	return ProbeBatch.GetNumQueued();
+}
+
+bool UClimbingMovementComponent::SampleLandscapeProbe(ULandscapeHeightfieldCollisionComponent* Landscape, EClimbingProbe Probe, const FVector& Start, const FVector& End)
+{
+	FHitResult Hit;
+	if (!Landscape || !LandscapeSampler.Raycast(Landscape, Start, End, Hit))
+	{
+		return false;
+	}
+
+	ProbeBatch.AddResolved(Probe, Start, End, Hit);
+	return true;
+}
+
+int32 UClimbingMovementComponent::SubmitQueuedProbes()
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbingProbe), false, CharacterOwner);
+	Params.bReturnPhysicalMaterial = true;
+	const int32 NumSweeps = ProbeBatch.Submit(GetWorld(), UpdatedComponent->GetComponentLocation(), ECC_Climbable, Params);
+	CLIMBING_COUNT_SWEEPS(NumSweeps);
+	return NumSweeps;
+}
+
+void UClimbingMovementComponent::DropQueuedProbes()
+{
+	// The vault probe was asked for once, it is asked for again with the next probes
+	bWantsVaultProbe |= ProbeBatch.IsQueued(EClimbingProbe::Vault);
+	ProbeBatch.ClearQueued();
+}
+
+bool UClimbingMovementComponent::GetProbeHit(EClimbingProbe Probe, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+	// On a landscape the height data is sampled where the probe is now, smoother than any plane a sweep found.
+	// The sample taken when the probes were queued is reused if the character did not move since
+	if (Probe != EClimbingProbe::Vault)
+	{
+		ULandscapeHeightfieldCollisionComponent* Landscape = GetSampledLandscape();
+		if (Landscape && (ProbeBatch.GetResolvedHit(Probe, Start, End, OutHit) || LandscapeSampler.Raycast(Landscape, Start, End, OutHit)))
+		{
+			INC_DWORD_STAT(STAT_ClimbingLandscapeHits);
+			CLIMBING_COUNT_LANDSCAPE_SAMPLES(1);
+			return true;
+		}
+	}
+
+	// A probe traced for this frame is used first, it refreshes or drops the cached surface before the tolerance runs out
+	const FClimbingProbeResult& Result = ProbeBatch.GetResult(Probe);
+	if (Result.bValid)
+	{
+		if (!Result.bHit)
+		{
+			SurfaceCache.Invalidate(Probe);
+			return false;
+		}
+
+		// A traced probe found the landscape again, whatever the character bumped into is behind
+		if (bLandscapeSamplingSuspended && FClimbingLandscapeSampler::CanSample(Result.Hit.GetComponent()))
+		{
+			bLandscapeSamplingSuspended = false;
+		}
+
+		// The probe was shot from where the character was last frame, move the hit along with it
+		const FVector Delta = UpdatedComponent->GetComponentLocation() - Result.Origin;
+		OutHit = Result.Hit;
+		OutHit.Location += Delta;
+		OutHit.ImpactPoint += Delta;
+		OutHit.TraceStart += Delta;
+		OutHit.TraceEnd += Delta;
+
+		// A moving base carried the surface along with the character since, the cache keeps it from where it is now
+		const UPrimitiveComponent* HitComponent = Result.Hit.GetComponent();
+		const bool bOnMovingBase = HitComponent && HitComponent == CharacterOwner->GetMovementBase() &&
+			MovementBaseUtility::UseRelativeLocation(HitComponent);
+		SurfaceCache.Store(Probe, bOnMovingBase ? OutHit : Result.Hit);
+		return true;
+	}
+
+	// The same surface was traced close enough to here
+	if (SurfaceCache.Query(Probe, Start, End, SurfaceCacheDistanceTolerance, SurfaceCacheAngleTolerance, OutHit))
+	{
+		INC_DWORD_STAT(STAT_ClimbingCacheHits);
+		return true;
+	}
+	INC_DWORD_STAT(STAT_ClimbingCacheMisses);
+
+	// Then from the baked surfaces. The probe ahead can reach a new wall, so it is traced near the edges of the
+	// current one; the probe in front of the character stays on the wall it is climbing
+	if (Probe != EClimbingProbe::Vault)
+	{
+		const UClimbableSurfaceIndex* SurfaceIndex = GetSurfaceIndex();
+		if (SurfaceIndex && SurfaceIndex->Raycast(Start, End, Probe == EClimbingProbe::Wall, OutHit))
+		{
+			INC_DWORD_STAT(STAT_ClimbingIndexHits);
+			return true;
+		}
+	}
+
+	// No result yet, assume the wall continues along the last known surface, where its component is now
+	FVector WallLocation, WallNormal;
+	if (!GetWallSurface(WallLocation, WallNormal)) return false;
+
+	const FVector TraceDirection = End - Start;
+	const float Denominator = FVector::DotProduct(TraceDirection, WallNormal);
+	if (FMath::IsNearlyZero(Denominator)) return false;
+
+	const float Time = FVector::DotProduct(WallLocation - Start, WallNormal) / Denominator;
+	if (Time < 0.f || Time > 1.f) return false;
+
+	const FVector Location = Start + Time * TraceDirection;
+	OutHit = FHitResult(Start, End);
+	OutHit.bBlockingHit = true;
+	OutHit.Time = Time;
+	OutHit.Location = Location;
+	OutHit.ImpactPoint = Location;
+	OutHit.Normal = WallNormal;
+	OutHit.ImpactNormal = WallNormal;
+	OutHit.Component = WallSurfaceBase;
+	OutHit.PhysMaterial = WallSurfaceMaterial;
+	return true;
+}
+
+void UClimbingMovementComponent::UpdateWallSurface(const FHitResult& Hit)
+{
+	SetWallSurface(Hit.Location, Hit.Normal, Hit.GetComponent());
+	WallSurfaceRules = GetSurfaceRules(Hit);
+	WallSurfaceMaterial = Hit.PhysMaterial;
+
+	// Hits from the surface index have no component, they are only found on static walls
+	if (UPrimitiveComponent* Component = Hit.GetComponent())
+	{
+		WallComponent = Component;
+	}
+}
+
+void UClimbingMovementComponent::SetWallSurface(const FVector& Location, const FVector& Normal, UPrimitiveComponent* Component)
+{
+	bHasWallSurface = true;
+	WallSurfaceLocation = Location;
+	WallSurfaceNormal = Normal.GetSafeNormal();
+	WallSurfaceBase.Reset();
+
+	if (Component && Component->Mobility == EComponentMobility::Movable)
+	{
+		const FTransform& ComponentToWorld = Component->GetComponentTransform();
+		WallSurfaceBase = Component;
+		WallSurfaceLocation = ComponentToWorld.InverseTransformPosition(Location);
+		WallSurfaceNormal = ComponentToWorld.InverseTransformVectorNoScale(WallSurfaceNormal);
+	}
+}
+
+bool UClimbingMovementComponent::GetWallSurface(FVector& OutLocation, FVector& OutNormal) const
+{
+	if (!bHasWallSurface || WallSurfaceBase.IsStale())
+	{
+		return false;
+	}
+
+	if (const UPrimitiveComponent* Component = WallSurfaceBase.Get())
+	{
+		const FTransform& ComponentToWorld = Component->GetComponentTransform();
+		OutLocation = ComponentToWorld.TransformPosition(WallSurfaceLocation);
+		OutNormal = ComponentToWorld.TransformVectorNoScale(WallSurfaceNormal);
+		return true;
+	}
+
+	OutLocation = WallSurfaceLocation;
+	OutNormal = WallSurfaceNormal;
+	return true;
+}
+
+void UClimbingMovementComponent::UpdateClimbingBase()
+{
+	UPrimitiveComponent* Component = WallComponent.Get();
+	if (Component && (IsClimbing() || IsHanging()) && CharacterOwner->GetMovementBase() != Component)
+	{
+		SetBase(Component);
+	}
+}
+
+void UClimbingMovementComponent::UpdateBasedMovement(float DeltaSeconds)
+{
+	// On the ground the base only carries the character along
+	if (!IsClimbing() && !IsHanging())
+	{
+		Super::UpdateBasedMovement(DeltaSeconds);
+		return;
+	}
+
+	const UPrimitiveComponent* MovementBase = CharacterOwner->GetMovementBase();
+	if (!MovementBaseUtility::UseRelativeLocation(MovementBase))
+	{
+		return;
+	}
+
+	if (!IsValid(MovementBase) || !IsValid(MovementBase->GetOwner()))
+	{
+		SetBase(nullptr);
+		return;
+	}
+
+	FVector NewBaseLocation;
+	FQuat NewBaseQuat;
+	if (!MovementBaseUtility::GetMovementBaseTransform(MovementBase, CharacterOwner->GetBasedMovement().BoneName, NewBaseLocation, NewBaseQuat))
+	{
+		return;
+	}
+
+	if (OldBaseLocation == NewBaseLocation && OldBaseQuat.Equals(NewBaseQuat, 1e-8f))
+	{
+		return;
+	}
+
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingBasedMovement);
+
+	// On a wall the whole pose keeps its place on the base, the rotation included. The wall surface and the
+	// surface cache are in the space of the base already, so they follow it without any probe
+	const FTransform OldBase(OldBaseQuat, OldBaseLocation);
+	const FTransform NewBase(NewBaseQuat, NewBaseLocation);
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	const FTransform Pose = FTransform(UpdatedComponent->GetComponentQuat(), OldLocation).GetRelativeTransform(OldBase) * NewBase;
+
+	// The base itself does not block the move, what is in the way of the character does
+	TGuardValue<EMoveComponentFlags> ScopedFlagRestore(MoveComponentFlags, MoveComponentFlags | MOVECOMP_IgnoreBases);
+	FHitResult MoveOnBaseHit(1.f);
+	MoveUpdatedComponent(Pose.GetLocation() - OldLocation, Pose.GetRotation(), true, &MoveOnBaseHit);
+
+	// The mesh interpolated between the fixed steps goes along, it would lag behind the base otherwise
+	const FTransform PreviousStep = FTransform(PreviousStepRotation, PreviousStepLocation).GetRelativeTransform(OldBase) * NewBase;
+	PreviousStepLocation = PreviousStep.GetLocation();
+	PreviousStepRotation = PreviousStep.GetRotation();
+
+	// A move to the wall or under the ledge still running is aimed at where the wall is now. Sources the movement
+	// dropped are only referenced here, a vault leaves the wall and is never carried
+	for (int32 Index = 0; Index < static_cast<int32>(EClimbingTransition::Num); ++Index)
+	{
+		const TSharedPtr<FRootMotionSource_MoveToDynamicForce>& MovePtr = TransitionMoves[Index];
+		if (Index != static_cast<int32>(EClimbingTransition::Vault) && MovePtr.IsValid() && !MovePtr.IsUnique())
+		{
+			MovePtr->StartLocation = NewBase.TransformPosition(OldBase.InverseTransformPosition(MovePtr->StartLocation));
+			MovePtr->SetTargetLocation(NewBase.TransformPosition(OldBase.InverseTransformPosition(MovePtr->TargetLocation)));
+		}
+	}
+}
+
+const UClimbableSurfaceIndex* UClimbingMovementComponent::GetSurfaceIndex() const
+{
+	if (WallComponent.IsValid() && WallComponent->Mobility == EComponentMobility::Movable)
+	{
+		return nullptr;
+	}
+
+	const UClimbingSubsystem* Subsystem = GetWorld()->GetSubsystem<UClimbingSubsystem>();
+	return Subsystem ? Subsystem->GetSurfaceIndex() : nullptr;
+}
+
+ULandscapeHeightfieldCollisionComponent* UClimbingMovementComponent::GetSampledLandscape() const
+{
+	if (!bSampleLandscapeHeight || bLandscapeSamplingSuspended)
+	{
+		return nullptr;
+	}
+	return Cast<ULandscapeHeightfieldCollisionComponent>(WallComponent.Get());
+}
+
+FClimbingSolverSettings UClimbingMovementComponent::GetSolverSettings() const
+{
+	FClimbingSolverSettings Settings;
+	Settings.MaxTurnAngle = MaxTurnAngle;
+	return Settings;
+}
+
+float UClimbingMovementComponent::GetCapsuleRadius() const
+{
+	return CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
+}
+
+float UClimbingMovementComponent::GetCapsuleHalfHeight() const
+{
+	return CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+}
+
+void FSavedMove_Climbing::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToClimb = false;
+	bSavedWantsWallJump = false;
+	bSavedReattachAtApex = false;
+	SavedWallJumpOutcome = EClimbingWallJumpOutcome::Pending;
+	SavedWallJumpVaultLocation = FVector::ZeroVector;
+	SavedClimbingStepAccumulator = 0.f;
+}
+
+uint8 FSavedMove_Climbing::GetCompressedFlags() const
+{
+	uint8 Result = Super::GetCompressedFlags();
+
+	if (bSavedWantsToClimb)
+	{
+		Result |= FLAG_WantsToClimb;
+	}
+	if (bSavedWantsWallJump)
+	{
+		Result |= FLAG_WallJump;
+	}
+	return Result;
+}
+
+bool FSavedMove_Climbing::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	const FSavedMove_Climbing* NewClimbingMove = static_cast<const FSavedMove_Climbing*>(NewMove.Get());
+	if (bSavedWantsToClimb != NewClimbingMove->bSavedWantsToClimb ||
+	    bSavedWantsWallJump != NewClimbingMove->bSavedWantsWallJump ||
+	    bSavedReattachAtApex != NewClimbingMove->bSavedReattachAtApex ||
+	    SavedWallJumpOutcome != NewClimbingMove->SavedWallJumpOutcome)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Climbing::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	const UClimbingMovementComponent* Movement = CastChecked<UClimbingMovementComponent>(C->GetCharacterMovement());
+	bSavedWantsToClimb = Movement->bWantsToClimb;
+	bSavedWantsWallJump = Movement->bWantsWallJump;
+	bSavedReattachAtApex = Movement->bReattachAtApex;
+	SavedWallJumpOutcome = Movement->WallJumpOutcome;
+	SavedWallJumpVaultLocation = Movement->WallJumpVaultLocation;
+	SavedClimbingStepAccumulator = Movement->ClimbingStepAccumulator;
+}
+
+void FSavedMove_Climbing::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	UClimbingMovementComponent* Movement = CastChecked<UClimbingMovementComponent>(C->GetCharacterMovement());
+	Movement->bWantsToClimb = bSavedWantsToClimb;
+	Movement->bWantsWallJump = bSavedWantsWallJump;
+	Movement->bReattachAtApex = bSavedReattachAtApex;
+	Movement->WallJumpOutcome = SavedWallJumpOutcome;
+	Movement->WallJumpVaultLocation = SavedWallJumpVaultLocation;
+	Movement->ClimbingStepAccumulator = SavedClimbingStepAccumulator;
+}
+
+void FSavedMove_Climbing::CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation)
+{
+	Super::CombineWith(OldMove, InCharacter, PC, OldStartLocation);
+
+	// The combined move starts over from the start of the old one, with the time it had accumulated
+	UClimbingMovementComponent* Movement = CastChecked<UClimbingMovementComponent>(InCharacter->GetCharacterMovement());
+	Movement->ClimbingStepAccumulator = static_cast<const FSavedMove_Climbing*>(OldMove)->SavedClimbingStepAccumulator;
+}
+
+void FClimbingNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_Climbing& ClimbingMove = static_cast<const FSavedMove_Climbing&>(ClientMove);
+	WallJumpOutcome = ClimbingMove.SavedWallJumpOutcome;
+	WallJumpVaultLocation = ClimbingMove.SavedWallJumpVaultLocation;
+}
+
+bool FClimbingNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// Two bits for the outcome, the location only comes with a vault
+	uint8 Outcome = static_cast<uint8>(WallJumpOutcome);
+	Ar.SerializeBits(&Outcome, 2);
+	WallJumpOutcome = static_cast<EClimbingWallJumpOutcome>(Outcome);
+
+	if (WallJumpOutcome == EClimbingWallJumpOutcome::Vault)
+	{
+		bool bLocationSuccess = true;
+		WallJumpVaultLocation.NetSerialize(Ar, PackageMap, bLocationSuccess);
+	}
+	return !Ar.IsError();
+}
+
+FClimbingNetworkMoveDataContainer::FClimbingNetworkMoveDataContainer()
+{
+	NewMoveData = &ClimbingMoveData[0];
+	PendingMoveData = &ClimbingMoveData[1];
+	OldMoveData = &ClimbingMoveData[2];
+}
+
+FNetworkPredictionData_Client_Climbing::FNetworkPredictionData_Client_Climbing(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Climbing::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_Climbing());
+}
@@ -0,0 +1,605 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbablePhysicalMaterial.h"
+#include "ClimbingLandscapeSampler.h"
+#include "ClimbingLedgeEdge.h"
+#include "ClimbingLedgeDetector.h"
+#include "ClimbingProbeBatch.h"
+#include "ClimbingRecording.h"
+#include "ClimbingSolver.h"
+#include "ClimbingSurfaceCache.h"
+#include "ClimbingWallJumpPredictor.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "ClimbingMovementComponent.generated.h"
+
+class UClimbableSurfaceIndex;
+class ULandscapeHeightfieldCollisionComponent;
+class UCurveFloat;
+class UCurveVector;
+
+/** Custom movement modes used by the climbing system */
+UENUM(BlueprintType)
+enum ECustomMovementMode
+{
+	CMOVE_None			UMETA(Hidden),
+	CMOVE_Climbing		UMETA(DisplayName = "Climbing"),
+	CMOVE_Hanging		UMETA(DisplayName = "Hanging"),
+	CMOVE_MAX			UMETA(Hidden),
+};
+
+/** Moves of the character in and out of the climbing state, each with a root motion source allocated once and reused */
+enum class EClimbingTransition : uint8
+{
+	/** Move to the wall when grabbing it from the ground */
+	Attach,
+	/** Move to the wall when grabbing it in the air, as at the apex of a wall jump */
+	Reattach,
+	/** Move on top of the wall */
+	Vault,
+	/** Move under the ledge when the character starts hanging from it */
+	Hang,
+
+	Num
+};
+
+/** Move data sent to the server with the climbing state the compressed flags have no room for */
+struct FClimbingNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	/** Outcome of the wall jump, decided by the client during the ascent */
+	EClimbingWallJumpOutcome WallJumpOutcome = EClimbingWallJumpOutcome::Pending;
+
+	/** Location on top of the wall, only sent with the Vault outcome */
+	FVector_NetQuantize10 WallJumpVaultLocation = FVector::ZeroVector;
+
+	//Begin FCharacterNetworkMoveData Interface
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+	//End FCharacterNetworkMoveData Interface
+};
+
+struct FClimbingNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FClimbingNetworkMoveDataContainer();
+
+	FClimbingNetworkMoveData ClimbingMoveData[3];
+};
+
+/**
+ * Character movement with a custom climbing mode. While climbing, the vertical and horizontal
+ * input are solved together: one surface solve, one move and one rotation update per step.
+ * The surface solve of all the climbers of a world is batched by UClimbingSubsystem.
+ */
+UCLASS()
+class UClimbingMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingMovementComponent();
+
+	/** Min angle allowed to be able to climb while moving on walls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	float MinClimbAngle;
+
+	/** Max angle allowed to be able to climb while moving on walls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	float MaxClimbAngle;
+
+	/** Max angle allowed to be able to turn while moving on walls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	float MaxTurnAngle;
+
+	/** Max speed while climbing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float MaxClimbSpeed;
+
+	/** Deceleration when there is no climbing input */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float BrakingDecelerationClimbing;
+
+	/** How fast the character rotates to face the wall */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float ClimbRotationInterpSpeed;
+
+	/** How far above the character the top of the wall is looked for while climbing up, one probe per frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float LedgeLookaheadDistance;
+
+	/** Size of the grid of probes fitted to find the orientation of the wall, 1 uses the normal of the probe ahead only */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="1", ClampMax="3", UIMin="1", UIMax="3"))
+	int32 SurfaceProbeGridSize;
+
+	/** Distance between the probes of the grid, as a fraction of the capsule radius horizontally and half height vertically */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float SurfaceProbeSpacing;
+
+	/** Probes of the grid farther than this from the fitted plane are ignored */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float SurfaceFitOutlierDistance;
+
+	/** Vertical speed of a jump up the wall, the character grabs the wall again at the apex */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float WallJumpVelocity;
+
+	/** Duration of the move to the wall when the character grabs it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float AttachDuration;
+
+	/** Duration of the move on top of the wall when the character vaults */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float VaultDuration;
+
+	/** Fraction of the move to the wall done over the fraction of AttachDuration elapsed, linear if not set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	UCurveFloat* AttachTimeCurve;
+
+	/** Fraction of the vault done over the fraction of VaultDuration elapsed, linear if not set */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	UCurveFloat* VaultTimeCurve;
+
+	/** Offset of the vault from the straight line to its end over the fraction of the move done,
+	 *  X along the move and Z up, to arc over the edge of the wall */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	UCurveVector* VaultPathCurve;
+
+	/** Runs the climbing steps at ClimbingStepRate instead of once per frame, and interpolates the mesh between the last two steps.
+	 *  The probes and the solve cost the same at any frame rate, and the server steps the moves of a client like the client did */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	bool bFixedStepClimbing;
+
+	/** Climbing steps per second with bFixedStepClimbing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="1", UIMin="10", UIMax="120", EditCondition="bFixedStepClimbing"))
+	float ClimbingStepRate;
+
+	/** Max climbing steps in a frame with bFixedStepClimbing, the time left over after a long frame is dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="1", UIMin="1", EditCondition="bFixedStepClimbing"))
+	int32 MaxClimbingStepsPerFrame;
+
+	/** Answers the probes on a landscape from its height data instead of tracing them, while the character climbs
+	 *  it and did not bump into anything else. Landscapes with a physical material per layer are always traced */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	bool bSampleLandscapeHeight;
+
+	/** Hangs from the top of the wall when there is no space to vault on top of it. While hanging the character shimmies
+	 *  along the edge with the horizontal input, climbs on top with up and goes back to the wall with down */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing")
+	bool bLedgeHang;
+
+	/** Distance from the edge down to the center of the capsule of a hanging character */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0", EditCondition="bLedgeHang"))
+	float HangVerticalOffset;
+
+	/** Speed along the edge while hanging */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0", EditCondition="bLedgeHang"))
+	float HangShimmySpeed;
+
+	/** How far ahead of the character the edge is scanned while it shimmies towards an end of the edge that was not scanned yet */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0", EditCondition="bLedgeHang"))
+	float LedgeScanDistance;
+
+	/** Points of the edge traced in one frame, each one is a trace down on top of the wall and one against its face */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="1", UIMin="1", EditCondition="bLedgeHang"))
+	int32 LedgeScanSamplesPerFrame;
+
+	/** Distance between the points traced along the edge */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="1", UIMin="1", EditCondition="bLedgeHang"))
+	float LedgeScanSpacing;
+
+	/** How far a probe can move from where it was last traced before the wall surface is traced again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float SurfaceCacheDistanceTolerance;
+
+	/** How much a probe can turn, in degrees, before the wall surface is traced again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Character Movement: Climbing", meta=(ClampMin="0", UIMin="0"))
+	float SurfaceCacheAngleTolerance;
+
+	/** Is the character in the climbing movement mode? */
+	UFUNCTION(BlueprintPure, Category="Character Movement: Climbing")
+	bool IsClimbing() const;
+
+	/** Is the character hanging from a ledge? */
+	UFUNCTION(BlueprintPure, Category="Character Movement: Climbing")
+	bool IsHanging() const;
+
+	/** Returns the edge of the ledge the character hangs from */
+	const FClimbingLedgeEdge& GetLedgeEdge() const { return LedgeEdge; }
+
+	/** Is the character moving on top of a ledge? */
+	UFUNCTION(BlueprintPure, Category="Character Movement: Climbing")
+	bool IsVaulting() const;
+
+	/** Requests to grab the wall in front of the character, or to let go of the wall being climbed.
+	 *  Applied by the next movement update and sent to the server with the saved move */
+	UFUNCTION(BlueprintCallable, Category="Character Movement: Climbing")
+	void SetWantsToClimb(bool bInWantsToClimb);
+
+	bool WantsToClimb() const { return bWantsToClimb; }
+
+	/** Requests a jump up the wall being climbed, applied by the next movement update */
+	UFUNCTION(BlueprintCallable, Category="Character Movement: Climbing")
+	void RequestWallJump();
+
+	/** Try to attach the character to the wall in front of it. Has to be called during the movement update
+	 *  to be predicted, use SetWantsToClimb from gameplay code
+	 *  @return True if a wall was found
+	 */
+	bool TryAttachToWall();
+
+	/** Detaches the character from the wall if he's climbing */
+	void DetachFromWall();
+
+	/** Settings of this climber for FClimbingSolver */
+	FClimbingSolverSettings GetSolverSettings() const;
+
+	/** Returns the cache of the wall surfaces found by the probes */
+	const FClimbingSurfaceCache& GetSurfaceCache() const { return SurfaceCache; }
+
+	/** Starts streaming the probe hits and surface solves of every frame of this climber to a file.
+	 *  While recording, every climbing step is solved by the component instead of the subsystem batch
+	 *  @return False if the file can't be written
+	 */
+	bool StartRecording(const FString& Filename);
+
+	void StopRecording();
+
+	//Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//End UActorComponent Interface
+
+	//Begin UMovementComponent Interface
+	virtual float GetMaxSpeed() const override;
+	//End UMovementComponent Interface
+
+	//Begin UCharacterMovementComponent Interface
+	virtual float GetMaxBrakingDeceleration() const override;
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual void NotifyJumpApex() override;
+	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+	//End UCharacterMovementComponent Interface
+
+protected:
+	//Begin UCharacterMovementComponent Interface
+	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+	virtual FVector ConstrainInputAcceleration(const FVector& InputAcceleration) const override;
+	virtual void UpdateBasedMovement(float DeltaSeconds) override;
+	//End UCharacterMovementComponent Interface
+
+	/** Movement update while climbing a wall, in fixed steps with bFixedStepClimbing */
+	void PhysClimbing(float deltaTime, int32 Iterations);
+
+	/** One climbing step: surface solve, move and rotation update */
+	void ClimbingStep(float deltaTime, int32 Iterations);
+
+	/** Movement update while hanging from a ledge, along the scanned edge */
+	void PhysHanging(float deltaTime, int32 Iterations);
+
+private:
+	friend class UClimbingSubsystem;
+	friend class FSavedMove_Climbing;
+
+	float GetClimbingStepTime() const;
+
+	/** Will the climbing move of a frame lasting DeltaTime run a step? Always true without bFixedStepClimbing */
+	bool IsClimbingStepDue(float DeltaTime) const;
+
+	/** Moves the mesh to the pose between the last two climbing steps, by the time accumulated toward the next one */
+	void UpdateClimbingStepVisuals();
+
+	/** Puts the mesh back on the capsule */
+	void ResetClimbingStepVisuals();
+
+	/** Climbing input on the wall plane, taken from the current acceleration. X is horizontal and Y vertical */
+	FVector2D GetClimbInput() const;
+
+	/** Engine of the climbing system movement: checks the wall in the direction of the input.
+	 *  Uses the solve of the subsystem batch if it was made for the same input
+	 *  @param ClimbInput Input on the wall plane, both axes range from -1 to 1
+	 *  @param OutDirection Direction the character has to move in
+	 *  @param OutRotation Rotation the character has to face the wall with
+	 *  @return True if the character can move
+	 */
+	bool SolveClimbSurface(const FVector2D& ClimbInput, FVector& OutDirection, FRotator& OutRotation);
+
+	/** Gets the hits of the probe ahead and the probe in front of the character, the normal of a missed probe is zero.
+	 *  Only touches the state of this component, so the climbers can be resolved in parallel */
+	void ResolveClimbProbes(const FVector2D& ClimbInput, FClimbingSolveInput& OutInput);
+
+	/** Climbing rules of the surface of a hit: the ones of this component, changed by a UClimbablePhysicalMaterial */
+	FClimbingSurfaceRules GetSurfaceRules(const FHitResult& Hit) const;
+
+	/** Game thread side of the solve: logging and vault
+	 *  @return True if the character can move
+	 */
+	bool ApplyClimbSolve(EClimbingSolveStatus Status, const FVector2D& ClimbInput, const FRotator& Rotation);
+
+	/** Stores the solve of the subsystem batch, used by the next climbing step */
+	void SetBatchSolve(const FVector2D& ClimbInput, const FVector& Location, const FClimbingSolveOutput& Solve);
+
+	/** Called when there is no wall in the direction of the input, vaults on top of the wall if there is space */
+	void TryVault(const FVector2D& ClimbInput);
+
+	/** When the character reaches the top of a wall, if there is enough
+	 *  space he vaults on top, with a root motion move to the free space
+	 *  @param Location Position the character will move to
+	 */
+	void VaultUp(const FVector& Location);
+
+	/** Called when the top of the wall is reached without space to vault, hangs from its edge
+	 *  @return True if the character started hanging
+	 */
+	bool TryHang();
+
+	/** Finds the top of the wall and its face around a point of the edge, with a trace down and a trace against the wall */
+	bool ScanLedgePoint(const FVector& Guess, const FVector& WallNormal, FHitResult& OutWallHit, FClimbingLedgePoint& OutPoint) const;
+
+	/** Follows the edge past one of its open ends for up to MaxSamples points, closes the end where the ledge stops or turns too much */
+	void ScanLedgeEdge(bool bAtEnd, int32 MaxSamples);
+
+	/** Location of the capsule of a character hanging from a point of the edge */
+	FVector GetHangLocation(const FClimbingLedgePoint& Point) const;
+
+	/** Climbs on top of the ledge from the hang if there is space for the capsule there
+	 *  @return True if the character vaulted
+	 */
+	bool TryClimbUpFromHang(const FClimbingLedgePoint& Point);
+
+	/** Leaves the wall with a jump up, the wall is grabbed again at the apex */
+	void WallJump();
+
+	/** The climber leaving the wall, as seen by the wall jump predictor */
+	FClimbingWallJumpFrame GetWallJumpFrame(const FVector& JumpVelocity) const;
+
+	/** Reads back the probes of the wall jump during the ascent. A vault or a drop is decided in the move the probes
+	 *  come back in and applied at the start of the next one, the first move whose saved move carries it */
+	void UpdateWallJumpPrediction();
+
+	/** Takes the wall jump outcome a client sent with its move, checked against the probes of the server */
+	void AcceptClientWallJumpOutcome(EClimbingWallJumpOutcome ClientOutcome, const FVector& ClientVaultLocation);
+
+	/** Vaults or lets go during the ascent of a wall jump, as decided in the last move */
+	void ApplyWallJumpOutcome();
+
+	/** Starts climbing the wall of a hit, with a move of a transition to it */
+	void AttachToWall(const FHitResult& WallHit, EClimbingTransition Transition);
+
+	/** Moves the character to a location with the root motion source of a transition, predicted like any other movement */
+	void ApplyClimbingMove(EClimbingTransition Transition, const FVector& Location);
+
+	/** Stops the moves to the wall in progress, when the character lets go of it before reaching it */
+	void CancelAttachMoves();
+
+	/** Performs a box trace in front of the character */
+	bool WallTrace(FHitResult& OutHit, FVector Start, FVector End, FColor Color) const;
+
+	/** Resets character Pitch when dropping from a wall */
+	void ResetRotation();
+
+	/** Computes the boxcast used to look for the wall in the direction the character is moving */
+	void GetAheadProbe(const FVector2D& ClimbInput, FVector& OutStart, FVector& OutEnd) const;
+
+	/** Computes the boxcast straight in front of the character */
+	void GetWallProbe(FVector& OutStart, FVector& OutEnd) const;
+
+	/** Position of the capsule cast checking if there is enough space to vault on top of the wall */
+	FVector GetVaultProbeLocation() const;
+
+	/** Queues the grid of probes around the probe ahead, submitted with it */
+	void AddProbePattern(const FVector& Start, const FVector& End, const FCollisionShape& Shape);
+
+	/** Fits a plane through the probe ahead and the grid around it
+	 *  @return False if the grid was not traced with the probe ahead or does not make a plane
+	 */
+	bool FitProbePattern(const FHitResult& AheadHit, struct FClimbingPlaneFitResult& OutFit) const;
+
+	/** Moves a probe hit on a fitted plane and gives it the normal of the plane */
+	static void ProjectOnFittedPlane(const struct FClimbingPlaneFitResult& Fit, FHitResult& InOutHit);
+
+	int32 GetSurfaceProbeGridSize() const;
+
+	/** Pose of the character for the ledge detector */
+	FClimbingLedgeFrame GetLedgeFrame() const;
+
+	/** Reads back the probes submitted last frame and feeds the ledge detector */
+	void ConsumeClimbProbes();
+
+	/** Queues the probes needed by the current climbing input, their results are used on the next frame
+	 *  @param bWithPattern If false, the grid of probes of the plane fit is left out
+	 *  @return Number of sweeps queued
+	 */
+	int32 QueueClimbProbes(bool bWithPattern);
+
+	/** Submits the queued probes as a single batch
+	 *  @return Number of sweeps issued
+	 */
+	int32 SubmitQueuedProbes();
+
+	/** Drops the queued probes, the climber moves along its last solved surface until it probes again */
+	void DropQueuedProbes();
+
+	/** Returns the hit of a probe, from the result submitted last frame moved by how much the character moved since,
+	 *  else from the surface cache if the probe did not move too much since it was traced.
+	 *  If neither is available, the hit is extrapolated from the last known wall surface
+	 *  @return True if the probe hit a wall
+	 */
+	bool GetProbeHit(EClimbingProbe Probe, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+	/** Stores the wall the character is climbing, used to extrapolate probes while results are pending */
+	void UpdateWallSurface(const FHitResult& Hit);
+
+	/** Stores the wall surface from a point and a normal in world space, relative to the component if it can move */
+	void SetWallSurface(const FVector& Location, const FVector& Normal, UPrimitiveComponent* Component);
+
+	/** Returns the last wall surface in world space, where its component is now
+	 *  @return False if there is none, or its component was destroyed
+	 */
+	bool GetWallSurface(FVector& OutLocation, FVector& OutNormal) const;
+
+	/** Makes the component of the wall being climbed the movement base, so the character is carried when it moves.
+	 *  Runs on the game thread, the wall itself may have been found while resolving the probes in parallel */
+	void UpdateClimbingBase();
+
+	/** Returns the baked surfaces of the level, null if there are none or the wall being climbed can move */
+	const UClimbableSurfaceIndex* GetSurfaceIndex() const;
+
+	/** Returns the landscape the probes are sampled on, null if the wall being climbed is not one or sampling is off */
+	ULandscapeHeightfieldCollisionComponent* GetSampledLandscape() const;
+
+	/** Answers a probe from the landscape when the probes are queued, and keeps the hit with the batch for GetProbeHit
+	 *  @return True if the landscape answered, the probe needs no sweep
+	 */
+	bool SampleLandscapeProbe(ULandscapeHeightfieldCollisionComponent* Landscape, EClimbingProbe Probe, const FVector& Start, const FVector& End);
+
+	float GetCapsuleRadius() const;
+	float GetCapsuleHalfHeight() const;
+
+	/** Is the character climbing? This is set to true after the character attached
+	 *  to a wall and did some movement, to avoid he tries to climb when he just
+	 *  attached */
+	bool bClimbing;
+
+	/** Climbing state requested by the input, replicated with the compressed flags of the saved moves */
+	bool bWantsToClimb;
+
+	/** Should the character jump up the wall on the next movement update? */
+	bool bWantsWallJump;
+
+	/** Should the character grab the wall again at the apex of the current jump? */
+	bool bReattachAtApex;
+
+	/** Probes the apex of the current wall jump, so it is grabbed without a query at the apex */
+	FClimbingWallJumpPredictor WallJumpPredictor;
+
+	/** What the current wall jump does, once its probes came back. It is sent to the server with the moves,
+	 *  which applies it in the same move as the client instead of when its own probes come back */
+	EClimbingWallJumpOutcome WallJumpOutcome;
+
+	/** Location on top of the wall, with the Vault outcome */
+	FVector WallJumpVaultLocation;
+
+	/** Should the vault capsule cast be submitted with the next probe batch? */
+	bool bWantsVaultProbe;
+
+	/** Is there a known wall surface to extrapolate the probes from? */
+	bool bHasWallSurface;
+
+	/** Point and normal of the last wall surface found in front of the character. They are in the space of
+	 *  WallSurfaceBase when it is set, so the surface follows a moving wall without being traced again */
+	FVector WallSurfaceLocation;
+	FVector WallSurfaceNormal;
+
+	/** Movable component the wall surface is relative to, null if it is in world space */
+	TWeakObjectPtr<UPrimitiveComponent> WallSurfaceBase;
+
+	/** Climbing rules of the wall being climbed */
+	FClimbingSurfaceRules WallSurfaceRules;
+
+	/** Material of the wall being climbed, carried by the probes extrapolated on its surface */
+	TWeakObjectPtr<UPhysicalMaterial> WallSurfaceMaterial;
+
+	/** Component of the wall being climbed, movable walls are never answered by the surface index */
+	TWeakObjectPtr<UPrimitiveComponent> WallComponent;
+
+	/** Probes submitted this frame, consumed the next one */
+	FClimbingProbeBatch ProbeBatch;
+
+	/** Answers the probes on the landscape being climbed */
+	FClimbingLandscapeSampler LandscapeSampler;
+
+	/** Did the character bump into something other than the landscape it climbs? The probes are traced until
+	 *  one of them hits the landscape again, as the heights can't see what stands on it */
+	bool bLandscapeSamplingSuspended;
+
+	/** Wall surfaces found by the probes, to skip tracing them again */
+	FClimbingSurfaceCache SurfaceCache;
+
+	/** Edge of the ledge the character hangs from */
+	FClimbingLedgeEdge LedgeEdge;
+
+	/** Was climbing on top tried for the current up input while hanging? It is tried again once the input is released */
+	bool bHangClimbUpTried;
+
+	/** Looks for the top of the wall ahead while climbing up */
+	FClimbingLedgeDetector LedgeDetector;
+
+	/** Solve computed by the subsystem batch before this component ticked, and the input it was made for */
+	bool bHasBatchSolve;
+	FVector2D BatchSolveInput;
+	FVector BatchSolveLocation;
+	FClimbingSolveOutput BatchSolve;
+
+	/** Root motion source of each transition. The movement holds a reference while the move runs and drops it when
+	 *  the move ends, then the same source is set up again for the next transition of that kind */
+	TSharedPtr<FRootMotionSource_MoveToDynamicForce> TransitionMoves[static_cast<int32>(EClimbingTransition::Num)];
+
+	/** Time since the last climbing step with bFixedStepClimbing, saved with the moves so replays step the same way */
+	float ClimbingStepAccumulator;
+
+	/** Pose of the capsule before the last climbing step, the start of the mesh interpolation */
+	FVector PreviousStepLocation;
+	FQuat PreviousStepRotation;
+
+	/** Is the mesh moved off the capsule by the step interpolation? */
+	bool bClimbingStepVisuals;
+
+	/** Active recording, see StartRecording() */
+	TUniquePtr<FClimbingRecorder> Recorder;
+
+	/** Move data of the client moves, with the climbing state */
+	FClimbingNetworkMoveDataContainer ClimbingMoveDataContainer;
+};
+
+/** Saved move with the climbing requests, replayed on correction and sent to the server as compressed flags */
+class FSavedMove_Climbing : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	//Begin FSavedMove_Character Interface
+	virtual void Clear() override;
+	virtual uint8 GetCompressedFlags() const override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+	virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* InCharacter, APlayerController* PC, const FVector& OldStartLocation) override;
+	//End FSavedMove_Character Interface
+
+	/** FLAG_Custom_0: the character wants to climb */
+	static constexpr uint8 FLAG_WantsToClimb = FLAG_Custom_0;
+
+	/** FLAG_Custom_1: the character jumps up the wall */
+	static constexpr uint8 FLAG_WallJump = FLAG_Custom_1;
+
+	uint8 bSavedWantsToClimb : 1;
+	uint8 bSavedWantsWallJump : 1;
+
+	/** Not sent, the server gets it from the wall jump. Restored when the move is replayed */
+	uint8 bSavedReattachAtApex : 1;
+
+	/** Sent with FClimbingNetworkMoveData, the server applies it in the same move. Restored when the move is
+	 *  replayed, so a replay does what the original move did even when the probes are gone */
+	EClimbingWallJumpOutcome SavedWallJumpOutcome;
+	FVector SavedWallJumpVaultLocation;
+
+	/** Not sent, the server accumulates the same time from the deltas of the moves. Restored when the move is replayed */
+	float SavedClimbingStepAccumulator;
+};
+
+class FNetworkPredictionData_Client_Climbing : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_Climbing(const UCharacterMovementComponent& ClientMovement);
+
+	//Begin FNetworkPredictionData_Client_Character Interface
+	virtual FSavedMovePtr AllocateNewMove() override;
+	//End FNetworkPredictionData_Client_Character Interface
+};
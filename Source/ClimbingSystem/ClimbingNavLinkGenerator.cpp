@@ -0,0 +1,451 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingNavLinkGenerator.h"
+
+#include "ClimbablePhysicalMaterial.h"
+#include "ClimbingMovementComponent.h"
+#include "ClimbingSolver.h"
+#include "ClimbingStats.h"
+#include "ClimbingSystem.h"
+#include "NavigationSystem.h"
+#include "NavLinkComponent.h"
+#include "Engine/Level.h"
+#include "Engine/LevelBounds.h"
+#include "HAL/IConsoleManager.h"
+
+static float GClimbingNavLinkBudgetMs = 0.5f;
+static FAutoConsoleVariableRef CVarClimbingNavLinkBudgetMs(
+	TEXT("climbing.NavLinkBudgetMs"),
+	GClimbingNavLinkBudgetMs,
+	TEXT("Game thread time in milliseconds the climb nav links can be looked for in a frame"));
+
+static float GClimbingNavLinkSampleSpacing = 150.f;
+static FAutoConsoleVariableRef CVarClimbingNavLinkSampleSpacing(
+	TEXT("climbing.NavLinkSampleSpacing"),
+	GClimbingNavLinkSampleSpacing,
+	TEXT("Distance between the navmesh points walls are looked for from"));
+
+static float GClimbingNavLinkMaxHeight = 1000.f;
+static FAutoConsoleVariableRef CVarClimbingNavLinkMaxHeight(
+	TEXT("climbing.NavLinkMaxHeight"),
+	GClimbingNavLinkMaxHeight,
+	TEXT("Highest wall an AI pawn is sent to climb"));
+
+namespace ClimbingNavLinks
+{
+	/** Size of the cells the levels are scanned in */
+	static constexpr float CellSize = 1000.f;
+
+	/** How far the ends of a path segment can be from the ends of a link for the segment to go along it */
+	static constexpr float FindTolerance = 50.f;
+
+	/** Is the surface of a hit climbable by the climber of the settings? */
+	static bool IsClimbable(const FHitResult& Hit, const FClimbableSurfaceBuildSettings& Settings)
+	{
+		FClimbingSurfaceRules Rules;
+		Rules.MinClimbAngle = Settings.MinClimbAngle;
+		Rules.MaxClimbAngle = Settings.MaxClimbAngle;
+		if (const UClimbablePhysicalMaterial* Material = Cast<UClimbablePhysicalMaterial>(Hit.PhysMaterial.Get()))
+		{
+			Material->ApplyTo(Rules);
+		}
+
+		const float ClimbAngle = FClimbingSolver::GetClimbAngle(Hit.Normal);
+		return Rules.bClimbable && ClimbAngle >= Rules.MinClimbAngle && ClimbAngle <= Rules.MaxClimbAngle;
+	}
+}
+
+void FClimbingNavLinkTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Generator)
+	{
+		Generator->ScanPendingCells();
+	}
+}
+
+FString FClimbingNavLinkTickFunction::DiagnosticMessage()
+{
+	return TEXT("UClimbingNavLinkGenerator[Scan]");
+}
+
+void UClimbingNavLinkGenerator::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickFunction.Generator = this;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = false;
+
+	const UWorld* World = GetWorld();
+	if (World && World->IsGameWorld())
+	{
+		ActorsInitializedHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &UClimbingNavLinkGenerator::OnActorsInitialized);
+		LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UClimbingNavLinkGenerator::OnLevelAdded);
+		LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UClimbingNavLinkGenerator::OnLevelRemoved);
+	}
+}
+
+void UClimbingNavLinkGenerator::Deinitialize()
+{
+	FWorldDelegates::OnWorldInitializedActors.Remove(ActorsInitializedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	TickFunction.UnRegisterTickFunction();
+
+	Cells.Reset();
+	PendingCells.Reset();
+	ScanLinks.Reset();
+	LevelBounds.Reset();
+	LinkHost = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UClimbingNavLinkGenerator::Rescan(const FBox& Bounds)
+{
+	QueueCells(Bounds);
+}
+
+const FClimbingNavLink* UClimbingNavLinkGenerator::FindLink(const FVector& Start, const FVector& End) const
+{
+	// The link may have been found from a sample of the next cell
+	const FIntPoint CenterKey = GetCellKey(Start);
+	const float ToleranceSquared = FMath::Square(ClimbingNavLinks::FindTolerance);
+	for (int32 X = -1; X <= 1; ++X)
+	{
+		for (int32 Y = -1; Y <= 1; ++Y)
+		{
+			const FCell* Cell = Cells.Find(CenterKey + FIntPoint(X, Y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (const FClimbingNavLink& Link : Cell->Links)
+			{
+				if (FVector::DistSquared(Link.Bottom, Start) <= ToleranceSquared && FVector::DistSquared(Link.Top, End) <= ToleranceSquared)
+				{
+					return &Link;
+				}
+			}
+		}
+	}
+	return nullptr;
+}
+
+int32 UClimbingNavLinkGenerator::GetNumLinks() const
+{
+	int32 NumLinks = 0;
+	for (const TPair<FIntPoint, FCell>& Pair : Cells)
+	{
+		NumLinks += Pair.Value.Links.Num();
+	}
+	return NumLinks;
+}
+
+void UClimbingNavLinkGenerator::OnActorsInitialized(const UWorld::FActorsInitializedParams& Params)
+{
+	if (Params.World == GetWorld())
+	{
+		OnLevelAdded(Params.World->PersistentLevel, Params.World);
+	}
+}
+
+void UClimbingNavLinkGenerator::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	// AI only moves on the server
+	if (!Level || World != GetWorld() || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	const FBox Bounds = ALevelBounds::CalculateLevelBounds(Level);
+	if (Bounds.IsValid)
+	{
+		LevelBounds.Add(Level, Bounds);
+		QueueCells(Bounds);
+	}
+}
+
+void UClimbingNavLinkGenerator::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	FBox Bounds;
+	if (!Level || World != GetWorld() || !LevelBounds.RemoveAndCopyValue(Level, Bounds))
+	{
+		return;
+	}
+
+	// The walls of the level are gone, the cells are scanned again for the levels still around them
+	const FIntPoint MinKey = GetCellKey(Bounds.Min);
+	const FIntPoint MaxKey = GetCellKey(Bounds.Max);
+	for (int32 X = MinKey.X; X <= MaxKey.X; ++X)
+	{
+		for (int32 Y = MinKey.Y; Y <= MaxKey.Y; ++Y)
+		{
+			if (FCell* Cell = Cells.Find(FIntPoint(X, Y)))
+			{
+				SetCellLinks(*Cell, TArray<FClimbingNavLink>());
+			}
+		}
+	}
+	QueueCells(Bounds);
+}
+
+void UClimbingNavLinkGenerator::QueueCells(const FBox& Bounds)
+{
+	UWorld* World = GetWorld();
+	if (!Bounds.IsValid || !World)
+	{
+		return;
+	}
+
+	const FIntPoint MinKey = GetCellKey(Bounds.Min);
+	const FIntPoint MaxKey = GetCellKey(Bounds.Max);
+	for (int32 X = MinKey.X; X <= MaxKey.X; ++X)
+	{
+		for (int32 Y = MinKey.Y; Y <= MaxKey.Y; ++Y)
+		{
+			const FIntPoint CellKey(X, Y);
+			FCell* Cell = Cells.Find(CellKey);
+			if (!Cell)
+			{
+				Cell = &Cells.Add(CellKey);
+				Cell->MinZ = Bounds.Min.Z;
+				Cell->MaxZ = Bounds.Max.Z;
+			}
+			else
+			{
+				Cell->MinZ = FMath::Min(Cell->MinZ, Bounds.Min.Z);
+				Cell->MaxZ = FMath::Max(Cell->MaxZ, Bounds.Max.Z);
+			}
+
+			// A cell queued again while it is scanned starts over, its height range may have grown
+			if (PendingCells.Num() > 0 && PendingCells[0] == CellKey)
+			{
+				NextSample = 0;
+				ScanLinks.Reset();
+			}
+			PendingCells.AddUnique(CellKey);
+		}
+	}
+
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+	TickFunction.SetTickFunctionEnable(true);
+}
+
+void UClimbingNavLinkGenerator::ScanPendingCells()
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingNavLinks);
+
+	// Streamed levels keep coming in while the game runs, the scan never takes more than its budget
+	const double EndTime = FPlatformTime::Seconds() + GClimbingNavLinkBudgetMs * 0.001;
+	while (PendingCells.Num() > 0 && FPlatformTime::Seconds() < EndTime)
+	{
+		const FIntPoint CellKey = PendingCells[0];
+		FCell* Cell = Cells.Find(CellKey);
+		if (Cell && ScanSample(CellKey, *Cell, NextSample))
+		{
+			++NextSample;
+			continue;
+		}
+
+		if (Cell)
+		{
+			SetCellLinks(*Cell, MoveTemp(ScanLinks));
+		}
+		PendingCells.RemoveAt(0, 1, false);
+		NextSample = 0;
+		ScanLinks.Reset();
+	}
+
+	if (PendingCells.Num() == 0)
+	{
+		TickFunction.SetTickFunctionEnable(false);
+		UE_LOG(LogClimbing, Verbose, TEXT("Climb nav links up to date, %d links"), GetNumLinks());
+	}
+}
+
+bool UClimbingNavLinkGenerator::ScanSample(const FIntPoint& CellKey, const FCell& Cell, int32 SampleIndex)
+{
+	const float Spacing = FMath::Max(GClimbingNavLinkSampleSpacing, 10.f);
+	const int32 NumSide = FMath::Max(FMath::CeilToInt(ClimbingNavLinks::CellSize / Spacing), 1);
+	if (SampleIndex >= NumSide * NumSide)
+	{
+		return false;
+	}
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	// One navmesh point in each square of the cell. A column with several floors only gets the one closest to the middle
+	const float SquareSize = ClimbingNavLinks::CellSize / NumSide;
+	const FVector Point(
+		(CellKey.X * NumSide + SampleIndex % NumSide + 0.5f) * SquareSize,
+		(CellKey.Y * NumSide + SampleIndex / NumSide + 0.5f) * SquareSize,
+		0.5f * (Cell.MinZ + Cell.MaxZ));
+	const FVector Extent(0.5f * SquareSize, 0.5f * SquareSize, 0.5f * (Cell.MaxZ - Cell.MinZ) + Settings.CapsuleHalfHeight);
+
+	FNavLocation NavPoint;
+	if (!NavSys->ProjectPointToNavigation(Point, NavPoint, Extent))
+	{
+		return true;
+	}
+
+	for (int32 Index = 0; Index < Settings.NumDirections; ++Index)
+	{
+		const FVector Direction = FRotator(0.f, 360.f * Index / Settings.NumDirections, 0.f).Vector();
+		FClimbingNavLink Link;
+		if (!FindClimb(NavPoint.Location, Direction, Link))
+		{
+			continue;
+		}
+
+		// The same climb is found from the samples next to this one
+		const bool bKnown = ScanLinks.ContainsByPredicate([&Link, Spacing](const FClimbingNavLink& Other)
+		{
+			return FVector::DistSquared(Other.Bottom, Link.Bottom) < FMath::Square(Spacing) &&
+				FVector::DistSquared(Other.Top, Link.Top) < FMath::Square(Spacing);
+		});
+		if (!bKnown)
+		{
+			ScanLinks.Add(Link);
+		}
+	}
+	return true;
+}
+
+bool UClimbingNavLinkGenerator::FindClimb(const FVector& NavPoint, const FVector& Direction, FClimbingNavLink& OutLink) const
+{
+	const UWorld* World = GetWorld();
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbingNavLinks), false);
+	Params.bReturnPhysicalMaterial = true;
+
+	// Same reach as the grab, with some room for where the pawn stops on the navmesh point
+	const float Reach = Settings.CapsuleRadius * 2.5f;
+	const FVector Center = NavPoint + FVector::UpVector * Settings.CapsuleHalfHeight;
+
+	FHitResult Hit;
+	if (!World->LineTraceSingleByChannel(Hit, Center, Center + Direction * Reach, ECC_Climbable, Params) ||
+	    !ClimbingNavLinks::IsClimbable(Hit, Settings))
+	{
+		return false;
+	}
+
+	const FVector WallNormal = FVector(Hit.Normal.X, Hit.Normal.Y, 0.f).GetSafeNormal();
+	if (FVector::DotProduct(WallNormal, Direction) > -0.5f)
+	{
+		return false;
+	}
+
+	// Up the wall until it runs out, the whole way has to be climbable
+	const float MaxHeight = FMath::Max(GClimbingNavLinkMaxHeight, Settings.CapsuleHalfHeight * 2.f);
+	float TopHeight = 0.f;
+	for (float Height = Settings.CapsuleHalfHeight; Height <= MaxHeight; Height += Settings.CapsuleHalfHeight)
+	{
+		const FVector Start = Center + FVector::UpVector * Height;
+		FHitResult WallHit;
+		if (!World->LineTraceSingleByChannel(WallHit, Start, Start - WallNormal * Reach * 2.f, ECC_Climbable, Params))
+		{
+			TopHeight = Height;
+			break;
+		}
+		if (!ClimbingNavLinks::IsClimbable(WallHit, Settings))
+		{
+			return false;
+		}
+	}
+	if (TopHeight <= 0.f)
+	{
+		return false;
+	}
+
+	// The floor on top of the wall, behind its edge
+	const FVector TopStart = FVector(Hit.Location.X, Hit.Location.Y, Center.Z) - WallNormal * Settings.CapsuleRadius * 2.f +
+		FVector::UpVector * (TopHeight + Settings.CapsuleHalfHeight * 2.f);
+	const FVector TopEnd = FVector(TopStart.X, TopStart.Y, Center.Z);
+	FHitResult FloorHit;
+	if (!World->LineTraceSingleByChannel(FloorHit, TopStart, TopEnd, ECC_Pawn, Params) ||
+	    FloorHit.ImpactNormal.Z < GetDefault<UClimbingMovementComponent>()->GetWalkableFloorZ() ||
+	    FloorHit.ImpactPoint.Z - NavPoint.Z <= Settings.CapsuleHalfHeight)
+	{
+		return false;
+	}
+
+	// Same clearance as the vault
+	const FCollisionShape Capsule = FCollisionShape::MakeCapsule(Settings.CapsuleRadius, Settings.CapsuleHalfHeight);
+	const FVector TopCenter = FloorHit.ImpactPoint + FVector::UpVector * (Settings.CapsuleHalfHeight + 2.f);
+	if (World->OverlapBlockingTestByChannel(TopCenter, FQuat::Identity, ECC_Pawn, Capsule, Params))
+	{
+		return false;
+	}
+
+	FNavLocation NavTop;
+	if (!NavSys || !NavSys->ProjectPointToNavigation(FloorHit.ImpactPoint, NavTop,
+	                                                 FVector(Settings.CapsuleRadius * 2.f, Settings.CapsuleRadius * 2.f, Settings.CapsuleHalfHeight)))
+	{
+		return false;
+	}
+
+	OutLink.Bottom = NavPoint;
+	OutLink.Top = NavTop.Location;
+	OutLink.WallNormal = WallNormal;
+	return true;
+}
+
+void UClimbingNavLinkGenerator::SetCellLinks(FCell& Cell, TArray<FClimbingNavLink>&& Links)
+{
+	Cell.Links = MoveTemp(Links);
+
+	UNavLinkComponent* Component = Cell.Component.Get();
+	if (!Component && Cell.Links.Num() == 0)
+	{
+		return;
+	}
+
+	if (!LinkHost)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		LinkHost = GetWorld()->SpawnActor<AActor>(SpawnParams);
+	}
+
+	// The component stays at the origin, so the ends of its links are in world space
+	const bool bNewComponent = !Component;
+	if (bNewComponent)
+	{
+		Component = NewObject<UNavLinkComponent>(LinkHost);
+		Cell.Component = Component;
+	}
+
+	Component->Links.Reset(Cell.Links.Num());
+	for (const FClimbingNavLink& Link : Cell.Links)
+	{
+		FNavigationLink& NavLink = Component->Links.Add_GetRef(FNavigationLink(Link.Bottom, Link.Top));
+		NavLink.Direction = ENavLinkDirection::LeftToRight;
+		NavLink.SnapRadius = Settings.CapsuleRadius;
+	}
+
+	if (bNewComponent)
+	{
+		Component->RegisterComponent();
+	}
+	else
+	{
+		FNavigationSystem::UpdateComponentData(*Component);
+	}
+}
+
+FIntPoint UClimbingNavLinkGenerator::GetCellKey(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / ClimbingNavLinks::CellSize), FMath::FloorToInt(Location.Y / ClimbingNavLinks::CellSize));
+}
@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbableSurfaceBuilder.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/World.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbingNavLinkGenerator.generated.h"
+
+class UClimbingNavLinkGenerator;
+class ULevel;
+class UNavLinkComponent;
+
+/** Climb from the navmesh at the foot of a wall to the navmesh on top of it */
+struct FClimbingNavLink
+{
+	/** Navmesh points the link connects */
+	FVector Bottom = FVector::ZeroVector;
+	FVector Top = FVector::ZeroVector;
+
+	/** Horizontal normal of the wall, the climber faces against it to grab the wall */
+	FVector WallNormal = FVector::ZeroVector;
+};
+
+/** Scans the pending cells of UClimbingNavLinkGenerator within climbing.NavLinkBudgetMs */
+USTRUCT()
+struct FClimbingNavLinkTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UClimbingNavLinkGenerator* Generator = nullptr;
+
+	//Begin FTickFunction Interface
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	//End FTickFunction Interface
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbingNavLinkTickFunction> : public TStructOpsTypeTraitsBase2<FClimbingNavLinkTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Finds the climbable walls next to the navmesh and links their foot to the navmesh on top of them, for AI
+ * pawns to climb with UClimbingPathFollowingComponent. Every level is scanned when it is added to the world,
+ * a cell at a time and a sample at a time within a budget per frame, and its links are dropped when it goes.
+ * The links are navmesh modifiers: the navmesh needs runtime generation for them to be built in.
+ */
+UCLASS()
+class UClimbingNavLinkGenerator : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//End USubsystem Interface
+
+	/** Scans an area again, replacing the links found in it. Call after moving climbable geometry */
+	void Rescan(const FBox& Bounds);
+
+	/** Returns the climb link a path segment goes along, null if the segment is not a climb */
+	const FClimbingNavLink* FindLink(const FVector& Start, const FVector& End) const;
+
+	int32 GetNumLinks() const;
+
+	/** Cells waiting to be scanned */
+	int32 GetNumPendingCells() const { return PendingCells.Num(); }
+
+private:
+	friend struct FClimbingNavLinkTickFunction;
+
+	struct FCell
+	{
+		/** Height range the cell is scanned in, from the bounds of the levels over it */
+		float MinZ = 0.f;
+		float MaxZ = 0.f;
+
+		TArray<FClimbingNavLink> Links;
+
+		/** Holds the links of the cell in the navigation system */
+		TWeakObjectPtr<UNavLinkComponent> Component;
+	};
+
+	void OnActorsInitialized(const UWorld::FActorsInitializedParams& Params);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+
+	/** Queues the cells over an area for a scan */
+	void QueueCells(const FBox& Bounds);
+
+	/** Scans pending cells until the budget of the frame is spent */
+	void ScanPendingCells();
+
+	/** Looks for climbs around a sample of a cell
+	 *  @return False if the cell has no sample with this index, it was fully scanned
+	 */
+	bool ScanSample(const FIntPoint& CellKey, const FCell& Cell, int32 SampleIndex);
+
+	/** Looks for a climbable wall in a direction from a navmesh point, and the navmesh on top of it */
+	bool FindClimb(const FVector& NavPoint, const FVector& Direction, FClimbingNavLink& OutLink) const;
+
+	/** Replaces the links of a cell, in the navigation system as well */
+	void SetCellLinks(FCell& Cell, TArray<FClimbingNavLink>&& Links);
+
+	FIntPoint GetCellKey(const FVector& Location) const;
+
+	FClimbingNavLinkTickFunction TickFunction;
+
+	/** Climber the walls are checked for */
+	FClimbableSurfaceBuildSettings Settings;
+
+	TMap<FIntPoint, FCell> Cells;
+
+	/** Cells waiting for a scan, the first one is being scanned */
+	TArray<FIntPoint> PendingCells;
+
+	/** Next sample of the cell being scanned, and the links found so far */
+	int32 NextSample = 0;
+	TArray<FClimbingNavLink> ScanLinks;
+
+	/** Bounds of the levels the links were generated for, to drop them with the level */
+	TMap<TWeakObjectPtr<ULevel>, FBox> LevelBounds;
+
+	/** Owner of the nav link components */
+	UPROPERTY()
+	AActor* LinkHost = nullptr;
+
+	FDelegateHandle ActorsInitializedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingPathFollowingComponent.h"
+
+#include "ClimbingMovementComponent.h"
+#include "GameFramework/Pawn.h"
+
+UClimbingPathFollowingComponent::UClimbingPathFollowingComponent()
+{
+	MaxGrabAttempts = 3;
+
+	bOnClimbLink = false;
+	bClimbStarted = false;
+	bGrabRequested = false;
+	GrabAttempts = 0;
+}
+
+void UClimbingPathFollowingComponent::OnPathFinished(const FPathFollowingResult& Result)
+{
+	// Don't leave the pawn hanging on the wall when the move is aborted
+	UClimbingMovementComponent* Movement = GetClimbingMovement();
+	if (bOnClimbLink && Movement && Movement->IsClimbing())
+	{
+		Movement->SetWantsToClimb(false);
+	}
+
+	ResetClimbLink();
+	Super::OnPathFinished(Result);
+}
+
+void UClimbingPathFollowingComponent::SetMoveSegment(int32 SegmentStartIndex)
+{
+	Super::SetMoveSegment(SegmentStartIndex);
+
+	ResetClimbLink();
+
+	const UWorld* World = GetWorld();
+	const UClimbingNavLinkGenerator* Generator = World ? World->GetSubsystem<UClimbingNavLinkGenerator>() : nullptr;
+	if (!Generator || !Path.IsValid() || !GetClimbingMovement())
+	{
+		return;
+	}
+
+	const TArray<FNavPathPoint>& PathPoints = Path->GetPathPoints();
+	if (!PathPoints.IsValidIndex(MoveSegmentStartIndex) || !PathPoints.IsValidIndex(MoveSegmentEndIndex))
+	{
+		return;
+	}
+
+	if (const FClimbingNavLink* Link = Generator->FindLink(PathPoints[MoveSegmentStartIndex].Location, PathPoints[MoveSegmentEndIndex].Location))
+	{
+		ClimbLink = *Link;
+		bOnClimbLink = true;
+	}
+}
+
+void UClimbingPathFollowingComponent::FollowPathSegment(float DeltaTime)
+{
+	UClimbingMovementComponent* Movement = GetClimbingMovement();
+	APawn* Pawn = Movement ? Movement->GetPawnOwner() : nullptr;
+	if (!bOnClimbLink || !Movement || !Pawn)
+	{
+		Super::FollowPathSegment(DeltaTime);
+		return;
+	}
+
+	if (Movement->IsClimbing())
+	{
+		bClimbStarted = true;
+		bGrabRequested = false;
+		Pawn->AddMovementInput(Pawn->GetActorUpVector());
+		return;
+	}
+
+	// Let the vault and the jump off the wall play out
+	if (Movement->IsVaulting() || Movement->IsFalling())
+	{
+		return;
+	}
+
+	if (bClimbStarted)
+	{
+		Super::FollowPathSegment(DeltaTime);
+		return;
+	}
+
+	// The grab is cleared by the movement update when no wall is found
+	if (bGrabRequested && !Movement->WantsToClimb())
+	{
+		bGrabRequested = false;
+		if (++GrabAttempts >= MaxGrabAttempts)
+		{
+			OnPathFinished(FPathFollowingResult(EPathFollowingResult::Blocked, FPathFollowingResultFlags::None));
+			return;
+		}
+	}
+
+	if (!bGrabRequested)
+	{
+		const FRotator FacingRotation = (-ClimbLink.WallNormal).GetSafeNormal2D().Rotation();
+		Pawn->SetActorRotation(FRotator(0.f, FacingRotation.Yaw, 0.f));
+		Movement->SetWantsToClimb(true);
+		bGrabRequested = true;
+	}
+}
+
+bool UClimbingPathFollowingComponent::UpdateBlockDetection()
+{
+	// Climbing is slow and the pawn waits at the foot of the wall while it grabs it
+	return bOnClimbLink ? false : Super::UpdateBlockDetection();
+}
+
+UClimbingMovementComponent* UClimbingPathFollowingComponent::GetClimbingMovement() const
+{
+	return Cast<UClimbingMovementComponent>(MovementComp);
+}
+
+void UClimbingPathFollowingComponent::ResetClimbLink()
+{
+	bOnClimbLink = false;
+	bClimbStarted = false;
+	bGrabRequested = false;
+	GrabAttempts = 0;
+}
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingNavLinkGenerator.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "ClimbingPathFollowingComponent.generated.h"
+
+class UClimbingMovementComponent;
+
+/**
+ * Follows paths going along the climb links of UClimbingNavLinkGenerator: at the foot of the wall the pawn
+ * faces it and grabs it, climbs up until it vaults over the top, then walks on to the end of the link.
+ * The path is given up as blocked if the wall can't be grabbed.
+ */
+UCLASS()
+class UClimbingPathFollowingComponent : public UPathFollowingComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingPathFollowingComponent();
+
+	/** Times the pawn tries to grab the wall of a climb link before giving up the path */
+	UPROPERTY(EditAnywhere, Category="Climbing", meta=(ClampMin="1"))
+	int32 MaxGrabAttempts;
+
+	/** Is the current path segment a climb? */
+	bool IsOnClimbLink() const { return bOnClimbLink; }
+
+	//Begin UPathFollowingComponent Interface
+	virtual void OnPathFinished(const FPathFollowingResult& Result) override;
+
+protected:
+	virtual void SetMoveSegment(int32 SegmentStartIndex) override;
+	virtual void FollowPathSegment(float DeltaTime) override;
+	virtual bool UpdateBlockDetection() override;
+	//End UPathFollowingComponent Interface
+
+private:
+	UClimbingMovementComponent* GetClimbingMovement() const;
+
+	void ResetClimbLink();
+
+	/** Climb of the current segment, valid while bOnClimbLink is set */
+	FClimbingNavLink ClimbLink;
+
+	bool bOnClimbLink;
+
+	/** Has the pawn been on the wall of the link? It walks to the end of the link once off it */
+	bool bClimbStarted;
+
+	/** Was the wall grab requested on the last update? */
+	bool bGrabRequested;
+
+	int32 GrabAttempts;
+};
@@ -0,0 +1,156 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingPlaneFit.h"
+
+namespace ClimbingPlaneFit
+{
+	/** Heights of the points over the reference plane, as a height field on its U and V axes */
+	struct FHeightField
+	{
+		VectorRegister Local[FClimbingPlaneFit::MaxPoints];
+		bool bInlier[FClimbingPlaneFit::MaxPoints];
+		int32 NumPoints = 0;
+	};
+
+	/** Fits Height = A * U + B * V through the centered inliers
+	 *  @return False if the inliers don't span the plane
+	 */
+	static bool SolveHeightField(const FHeightField& Field, float& OutA, float& OutB)
+	{
+		// Row U: (UU, VU, HU, 0), row V: (UV, VV, HV, 0)
+		VectorRegister RowU = VectorZero();
+		VectorRegister RowV = VectorZero();
+		for (int32 Index = 0; Index < Field.NumPoints; ++Index)
+		{
+			if (Field.bInlier[Index])
+			{
+				const VectorRegister& Local = Field.Local[Index];
+				RowU = VectorMultiplyAdd(Local, VectorReplicate(Local, 0), RowU);
+				RowV = VectorMultiplyAdd(Local, VectorReplicate(Local, 1), RowV);
+			}
+		}
+
+		float SumsU[4], SumsV[4];
+		VectorStore(RowU, SumsU);
+		VectorStore(RowV, SumsV);
+
+		// Normal equations of the least squares fit
+		const float Determinant = SumsU[0] * SumsV[1] - SumsU[1] * SumsV[0];
+		if (FMath::Abs(Determinant) <= KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		OutA = (SumsU[2] * SumsV[1] - SumsV[2] * SumsU[1]) / Determinant;
+		OutB = (SumsV[2] * SumsU[0] - SumsU[2] * SumsV[0]) / Determinant;
+		return true;
+	}
+
+	/** Centers the inliers on their centroid, in the local frame
+	 *  @return Number of inliers
+	 */
+	static int32 CenterInliers(FHeightField& Field, VectorRegister& OutCentroid)
+	{
+		VectorRegister Sum = VectorZero();
+		int32 NumInliers = 0;
+		for (int32 Index = 0; Index < Field.NumPoints; ++Index)
+		{
+			if (Field.bInlier[Index])
+			{
+				Sum = VectorAdd(Sum, Field.Local[Index]);
+				++NumInliers;
+			}
+		}
+
+		OutCentroid = NumInliers > 0 ? VectorDivide(Sum, VectorSetFloat1(static_cast<float>(NumInliers))) : VectorZero();
+		for (int32 Index = 0; Index < Field.NumPoints; ++Index)
+		{
+			Field.Local[Index] = VectorSubtract(Field.Local[Index], OutCentroid);
+		}
+		return NumInliers;
+	}
+}
+
+bool FClimbingPlaneFit::Fit(TArrayView<const FVector> Points, const FVector& ReferenceNormal, float OutlierDistance, FClimbingPlaneFitResult& OutResult)
+{
+	using namespace ClimbingPlaneFit;
+
+	const FVector AxisN = ReferenceNormal.GetSafeNormal();
+	if (Points.Num() < 3 || AxisN.IsZero())
+	{
+		return false;
+	}
+
+	FVector AxisU, AxisV;
+	AxisN.FindBestAxisVectors(AxisU, AxisV);
+
+	// Columns of the world to local rotation, a point goes to (U, V, Height, 0) with three multiply adds
+	const VectorRegister ColumnX = VectorSet(AxisU.X, AxisV.X, AxisN.X, 0.f);
+	const VectorRegister ColumnY = VectorSet(AxisU.Y, AxisV.Y, AxisN.Y, 0.f);
+	const VectorRegister ColumnZ = VectorSet(AxisU.Z, AxisV.Z, AxisN.Z, 0.f);
+
+	FHeightField Field;
+	Field.NumPoints = FMath::Min(Points.Num(), MaxPoints);
+	for (int32 Index = 0; Index < Field.NumPoints; ++Index)
+	{
+		const FVector& Point = Points[Index];
+		VectorRegister Local = VectorMultiply(ColumnX, VectorSetFloat1(Point.X));
+		Local = VectorMultiplyAdd(ColumnY, VectorSetFloat1(Point.Y), Local);
+		Local = VectorMultiplyAdd(ColumnZ, VectorSetFloat1(Point.Z), Local);
+		Field.Local[Index] = Local;
+		Field.bInlier[Index] = true;
+	}
+
+	VectorRegister Centroid;
+	int32 NumInliers = CenterInliers(Field, Centroid);
+	float A = 0.f, B = 0.f;
+	if (!SolveHeightField(Field, A, B))
+	{
+		return false;
+	}
+
+	// Drop the points off the first plane, like a probe that went through a gap, and fit again
+	const VectorRegister Residual = VectorSet(-A, -B, 1.f, 0.f);
+	bool bRejected = false;
+	for (int32 Index = 0; Index < Field.NumPoints && OutlierDistance > 0.f; ++Index)
+	{
+		const float Distance = FMath::Abs(VectorGetComponent(VectorDot3(Field.Local[Index], Residual), 0));
+		if (Distance > OutlierDistance)
+		{
+			Field.bInlier[Index] = false;
+			bRejected = true;
+		}
+	}
+
+	if (bRejected)
+	{
+		VectorRegister InlierCentroid;
+		NumInliers = CenterInliers(Field, InlierCentroid);
+		Centroid = VectorAdd(Centroid, InlierCentroid);
+		if (NumInliers < 3 || !SolveHeightField(Field, A, B))
+		{
+			return false;
+		}
+	}
+
+	// Distances from the final plane, along its normal
+	const FVector LocalNormal = FVector(-A, -B, 1.f).GetSafeNormal();
+	const VectorRegister LocalNormalRegister = VectorSet(LocalNormal.X, LocalNormal.Y, LocalNormal.Z, 0.f);
+	float SquaredError = 0.f;
+	for (int32 Index = 0; Index < Field.NumPoints; ++Index)
+	{
+		if (Field.bInlier[Index])
+		{
+			SquaredError += FMath::Square(VectorGetComponent(VectorDot3(Field.Local[Index], LocalNormalRegister), 0));
+		}
+	}
+
+	float CentroidLocal[4];
+	VectorStore(Centroid, CentroidLocal);
+
+	OutResult.Point = AxisU * CentroidLocal[0] + AxisV * CentroidLocal[1] + AxisN * CentroidLocal[2];
+	OutResult.Normal = (AxisU * LocalNormal.X + AxisV * LocalNormal.Y + AxisN * LocalNormal.Z).GetSafeNormal();
+	OutResult.NumInliers = NumInliers;
+	OutResult.RmsError = FMath::Sqrt(SquaredError / NumInliers);
+	return true;
+}
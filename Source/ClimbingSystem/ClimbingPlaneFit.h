@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Plane fitted through the hits of the surface probes */
+struct FClimbingPlaneFitResult
+{
+	/** Centroid of the inliers, on the plane */
+	FVector Point = FVector::ZeroVector;
+
+	FVector Normal = FVector::ZeroVector;
+
+	/** Number of points kept by the fit */
+	int32 NumInliers = 0;
+
+	/** Root mean square distance of the inliers from the plane */
+	float RmsError = 0.f;
+};
+
+/**
+ * Least squares plane fit of a handful of points, with outlier rejection. Only depends on Core, so it
+ * can be exercised on its own. The sums are accumulated with VectorRegister math, the cost is fixed
+ * for a given number of points.
+ */
+struct FClimbingPlaneFit
+{
+	/** Max points of a fit, the size of the probe pattern */
+	static constexpr int32 MaxPoints = 9;
+
+	/** Fits a plane through the points
+	 *  @param ReferenceNormal Approximate normal of the surface, the fitted normal faces the same side
+	 *  @param OutlierDistance Points farther than this from the first fit are dropped and the plane fitted again
+	 *  @return False if there are less than three usable points or they are aligned
+	 */
+	static bool Fit(TArrayView<const FVector> Points, const FVector& ReferenceNormal, float OutlierDistance, FClimbingPlaneFitResult& OutResult);
+};
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingPlaneFit.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbingPlaneFitTest
+{
+	static constexpr int32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	/** A 3x3 grid of points on a plane, like the probe pattern around the probe ahead */
+	static void MakeGrid(const FVector& Origin, const FVector& Normal, float Spacing, TArray<FVector>& OutPoints)
+	{
+		FVector AxisU, AxisV;
+		Normal.GetSafeNormal().FindBestAxisVectors(AxisU, AxisV);
+		OutPoints.Reset();
+		for (int32 Row = -1; Row <= 1; ++Row)
+		{
+			for (int32 Column = -1; Column <= 1; ++Column)
+			{
+				OutPoints.Add(Origin + AxisU * (Column * Spacing) + AxisV * (Row * Spacing));
+			}
+		}
+	}
+
+	static float AngleBetween(const FVector& A, const FVector& B)
+	{
+		return FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(A.GetSafeNormal(), B.GetSafeNormal()), -1.f, 1.f)));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingPlaneFitExactTest, "ClimbingSystem.PlaneFit.ExactPlane", ClimbingPlaneFitTest::TestFlags)
+
+bool FClimbingPlaneFitExactTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingPlaneFitTest;
+
+	const FVector Normal = FVector(-1.f, 0.3f, 0.2f).GetSafeNormal();
+	const FVector Origin(500.f, -200.f, 150.f);
+	TArray<FVector> Points;
+	MakeGrid(Origin, Normal, 30.f, Points);
+
+	// A reference a few degrees off, like the normal of the single probe hit
+	FClimbingPlaneFitResult Result;
+	TestTrue(TEXT("Fit succeeds"), FClimbingPlaneFit::Fit(Points, (Normal + FVector(0.f, 0.f, 0.1f)).GetSafeNormal(), 10.f, Result));
+	TestTrue(TEXT("Normal matches the plane"), AngleBetween(Result.Normal, Normal) < 0.01f);
+	TestEqual(TEXT("Point is the centroid"), Result.Point, Origin, 0.01f);
+	TestEqual(TEXT("Every point is an inlier"), Result.NumInliers, Points.Num());
+	TestTrue(TEXT("No error on an exact plane"), Result.RmsError < 0.01f);
+
+	// The normal faces the side of the reference
+	TestTrue(TEXT("Fit with a flipped reference succeeds"), FClimbingPlaneFit::Fit(Points, -Normal, 10.f, Result));
+	TestTrue(TEXT("Normal follows the reference side"), AngleBetween(Result.Normal, -Normal) < 0.01f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingPlaneFitNoiseTest, "ClimbingSystem.PlaneFit.NoisySamples", ClimbingPlaneFitTest::TestFlags)
+
+bool FClimbingPlaneFitNoiseTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingPlaneFitTest;
+
+	const FVector Normal = FVector(0.f, 1.f, 0.4f).GetSafeNormal();
+	TArray<FVector> Points;
+	MakeGrid(FVector(0.f, 100.f, 80.f), Normal, 30.f, Points);
+
+	// Rough rock: every point off the plane by up to a unit, well under the outlier distance
+	FRandomStream Random(1234);
+	for (FVector& Point : Points)
+	{
+		Point += Normal * Random.FRandRange(-1.f, 1.f);
+	}
+
+	FClimbingPlaneFitResult Result;
+	TestTrue(TEXT("Fit succeeds"), FClimbingPlaneFit::Fit(Points, Normal, 10.f, Result));
+	TestTrue(TEXT("Normal is close to the plane"), AngleBetween(Result.Normal, Normal) < 3.f);
+	TestEqual(TEXT("Noise is not rejected"), Result.NumInliers, Points.Num());
+	TestTrue(TEXT("Error is within the noise"), Result.RmsError > 0.f && Result.RmsError <= 1.f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingPlaneFitOutlierTest, "ClimbingSystem.PlaneFit.OutlierRejection", ClimbingPlaneFitTest::TestFlags)
+
+bool FClimbingPlaneFitOutlierTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingPlaneFitTest;
+
+	const FVector Normal(-1.f, 0.f, 0.f);
+	TArray<FVector> Points;
+	MakeGrid(FVector(300.f, 0.f, 100.f), Normal, 30.f, Points);
+
+	// A corner probe went through a gap and hit the wall behind
+	Points[0] -= Normal * 25.f;
+
+	FClimbingPlaneFitResult Rejected;
+	TestTrue(TEXT("Fit with rejection succeeds"), FClimbingPlaneFit::Fit(Points, Normal, 10.f, Rejected));
+	TestEqual(TEXT("The outlier is dropped"), Rejected.NumInliers, Points.Num() - 1);
+	TestTrue(TEXT("Normal ignores the outlier"), AngleBetween(Rejected.Normal, Normal) < 0.01f);
+	TestTrue(TEXT("No error left on the inliers"), Rejected.RmsError < 0.01f);
+
+	FClimbingPlaneFitResult Kept;
+	TestTrue(TEXT("Fit without rejection succeeds"), FClimbingPlaneFit::Fit(Points, Normal, 0.f, Kept));
+	TestEqual(TEXT("Every point is kept without rejection"), Kept.NumInliers, Points.Num());
+	TestTrue(TEXT("The outlier tilts the plane without rejection"), AngleBetween(Kept.Normal, Normal) > 1.f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingPlaneFitDegenerateTest, "ClimbingSystem.PlaneFit.Degenerate", ClimbingPlaneFitTest::TestFlags)
+
+bool FClimbingPlaneFitDegenerateTest::RunTest(const FString& Parameters)
+{
+	const FVector Normal(-1.f, 0.f, 0.f);
+	FClimbingPlaneFitResult Result;
+
+	const TArray<FVector> TwoPoints = { FVector(0.f, 0.f, 0.f), FVector(0.f, 30.f, 0.f) };
+	TestFalse(TEXT("Two points make no plane"), FClimbingPlaneFit::Fit(TwoPoints, Normal, 10.f, Result));
+
+	const TArray<FVector> Aligned = { FVector(0.f, -30.f, 0.f), FVector(0.f, 0.f, 0.f), FVector(0.f, 30.f, 0.f), FVector(0.f, 60.f, 0.f) };
+	TestFalse(TEXT("Aligned points make no plane"), FClimbingPlaneFit::Fit(Aligned, Normal, 10.f, Result));
+
+	const TArray<FVector> Grid = { FVector(0.f, 0.f, 0.f), FVector(0.f, 30.f, 0.f), FVector(0.f, 0.f, 30.f) };
+	TestFalse(TEXT("A zero reference normal is rejected"), FClimbingPlaneFit::Fit(Grid, FVector::ZeroVector, 10.f, Result));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingProbeBatch.h"
+
+#include "Engine/World.h"
+
+FClimbingProbeBatch::FClimbingProbeBatch()
+	: SubmittedOrigin(FVector::ZeroVector)
+{
+}
+
+void FClimbingProbeBatch::AddSweep(EClimbingProbe Probe, const FVector& Start, const FVector& End, const FCollisionShape& Shape)
+{
+	AddSweepToSlot(static_cast<int32>(Probe), Start, End, Shape);
+}
+
+void FClimbingProbeBatch::AddPatternSweep(int32 PatternIndex, const FVector& Start, const FVector& End, const FCollisionShape& Shape)
+{
+	AddSweepToSlot(GetPatternSlot(PatternIndex), Start, End, Shape);
+}
+
+void FClimbingProbeBatch::AddSweepToSlot(int32 Slot, const FVector& Start, const FVector& End, const FCollisionShape& Shape)
+{
+	FQueuedSweep& Sweep = Queued[Slot];
+	Sweep.Start = Start;
+	Sweep.End = End;
+	Sweep.Shape = Shape;
+	Sweep.bQueued = true;
+}
+
+int32 FClimbingProbeBatch::Submit(UWorld* World, const FVector& Origin, ECollisionChannel Channel, const FCollisionQueryParams& Params)
+{
+	check(World);
+	SubmittedOrigin = Origin;
+	int32 NumSubmitted = 0;
+
+	for (int32 Index = 0; Index < NumProbes; ++Index)
+	{
+		FQueuedSweep& Sweep = Queued[Index];
+		if (!Sweep.bQueued)
+		{
+			Handles[Index] = FTraceHandle();
+			continue;
+		}
+
+		Handles[Index] = World->AsyncSweepByChannel(EAsyncTraceType::Single, Sweep.Start, Sweep.End, FQuat::Identity,
+		                                            Channel, Sweep.Shape, Params);
+		Sweep.bQueued = false;
+		++NumSubmitted;
+	}
+
+	return NumSubmitted;
+}
+
+int32 FClimbingProbeBatch::GetNumQueued() const
+{
+	int32 NumQueued = 0;
+	for (int32 Index = 0; Index < NumProbes; ++Index)
+	{
+		NumQueued += Queued[Index].bQueued ? 1 : 0;
+	}
+	return NumQueued;
+}
+
+void FClimbingProbeBatch::ClearQueued()
+{
+	for (int32 Index = 0; Index < NumProbes; ++Index)
+	{
+		Queued[Index] = FQueuedSweep();
+	}
+}
+
+int32 FClimbingProbeBatch::Consume(UWorld* World)
+{
+	check(World);
+	int32 NumConsumed = 0;
+
+	for (int32 Index = 0; Index < NumProbes; ++Index)
+	{
+		FClimbingProbeResult& Result = Results[Index];
+		Result = FClimbingProbeResult();
+
+		FTraceDatum Datum;
+		if (!Handles[Index].IsValid() || !World->QueryTraceData(Handles[Index], Datum))
+		{
+			continue;
+		}
+
+		Result.bValid = true;
+		Result.Origin = SubmittedOrigin;
+		Result.bHit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+		if (Result.bHit)
+		{
+			Result.Hit = Datum.OutHits[0];
+		}
+		Handles[Index] = FTraceHandle();
+		++NumConsumed;
+	}
+
+	return NumConsumed;
+}
+
+void FClimbingProbeBatch::AddResolved(EClimbingProbe Probe, const FVector& Start, const FVector& End, const FHitResult& Hit)
+{
+	FResolvedProbe& Probed = Resolved[static_cast<int32>(Probe)];
+	Probed.Start = Start;
+	Probed.End = End;
+	Probed.Hit = Hit;
+	Probed.bValid = true;
+}
+
+void FClimbingProbeBatch::ClearResolved()
+{
+	for (FResolvedProbe& Probed : Resolved)
+	{
+		Probed = FResolvedProbe();
+	}
+}
+
+bool FClimbingProbeBatch::GetResolvedHit(EClimbingProbe Probe, const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	// The character did not move since, the probe would get the same answer
+	const FResolvedProbe& Probed = Resolved[static_cast<int32>(Probe)];
+	if (!Probed.bValid || !Probed.Start.Equals(Start, 0.1f) || !Probed.End.Equals(End, 0.1f))
+	{
+		return false;
+	}
+
+	OutHit = Probed.Hit;
+	return true;
+}
+
+void FClimbingProbeBatch::Reset()
+{
+	for (int32 Index = 0; Index < NumProbes; ++Index)
+	{
+		Queued[Index] = FQueuedSweep();
+		Handles[Index] = FTraceHandle();
+		Results[Index] = FClimbingProbeResult();
+	}
+	ClearResolved();
+}
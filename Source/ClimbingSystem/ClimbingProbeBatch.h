@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "CollisionShape.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+
+/** Probes a climber can issue in a single frame */
+enum class EClimbingProbe : uint8
+{
+	/** Boxcast ahead of the character, in the direction it is climbing */
+	Ahead,
+	/** Boxcast straight in front of the character */
+	Wall,
+	/** Capsule cast above the top of the wall, to check if there is space to vault */
+	Vault,
+	/** Lookahead probe of the ledge detector, a boxcast or a capsule cast */
+	Ledge,
+
+	Num
+};
+
+/** Result of a probe, together with the actor location it was issued from */
+struct FClimbingProbeResult
+{
+	FHitResult Hit;
+
+	/** Actor location when the probe was submitted */
+	FVector Origin = FVector::ZeroVector;
+
+	/** True if the probe hit something */
+	bool bHit = false;
+
+	/** False if no data came back for this probe, because it was not submitted or is still pending */
+	bool bValid = false;
+};
+
+/**
+ * Collects all the probes of a climber for a frame and submits them together as async sweeps.
+ * The physics scene resolves them at the end of the frame, so results are read back the next one.
+ */
+class FClimbingProbeBatch
+{
+public:
+	FClimbingProbeBatch();
+
+	/** Queues a sweep, it is issued on the next Submit() */
+	void AddSweep(EClimbingProbe Probe, const FVector& Start, const FVector& End, const FCollisionShape& Shape);
+
+	/** Issues every queued sweep to the async trace system
+	 *  @param Origin Actor location the sweeps were computed from
+	 *  @return Number of sweeps issued
+	 */
+	int32 Submit(UWorld* World, const FVector& Origin, ECollisionChannel Channel, const FCollisionQueryParams& Params);
+
+	/** Number of sweeps queued for the next Submit() */
+	int32 GetNumQueued() const;
+
+	bool IsQueued(EClimbingProbe Probe) const { return Queued[static_cast<int32>(Probe)].bQueued; }
+
+	/** Drops the queued sweeps without issuing them, the probes come back as not valid */
+	void ClearQueued();
+
+	/** Reads back the sweeps submitted last frame. Has to be called before Submit(), as that
+	 *  overwrites the pending handles
+	 *  @return Number of probes that came back
+	 */
+	int32 Consume(UWorld* World);
+
+	/** Result of a probe, as gathered by the last Consume() */
+	const FClimbingProbeResult& GetResult(EClimbingProbe Probe) const { return Results[static_cast<int32>(Probe)]; }
+
+	/** Max probes of the surface pattern, shot around the probe ahead to fit the wall plane */
+	static constexpr int32 MaxPatternProbes = 9;
+
+	/** Queues a sweep of the surface pattern, it is issued on the next Submit() with the other probes */
+	void AddPatternSweep(int32 PatternIndex, const FVector& Start, const FVector& End, const FCollisionShape& Shape);
+
+	/** Result of a probe of the surface pattern, as gathered by the last Consume() */
+	const FClimbingProbeResult& GetPatternResult(int32 PatternIndex) const { return Results[GetPatternSlot(PatternIndex)]; }
+
+	/** Keeps a probe that was answered without a sweep when the batch was queued, like a landscape sample, so
+	 *  it is not answered again when it is read back from the same place */
+	void AddResolved(EClimbingProbe Probe, const FVector& Start, const FVector& End, const FHitResult& Hit);
+
+	/** Forgets the probes answered when the batch was queued */
+	void ClearResolved();
+
+	/** Returns a probe answered when the batch was queued, if it went from the same start to the same end */
+	bool GetResolvedHit(EClimbingProbe Probe, const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+
+	/** Drops queued sweeps, pending handles and results */
+	void Reset();
+
+private:
+	/** The named probes come first, then the ones of the pattern */
+	static constexpr int32 NumProbes = static_cast<int32>(EClimbingProbe::Num) + MaxPatternProbes;
+
+	static int32 GetPatternSlot(int32 PatternIndex)
+	{
+		check(PatternIndex >= 0 && PatternIndex < MaxPatternProbes);
+		return static_cast<int32>(EClimbingProbe::Num) + PatternIndex;
+	}
+
+	void AddSweepToSlot(int32 Slot, const FVector& Start, const FVector& End, const FCollisionShape& Shape);
+
+	struct FQueuedSweep
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		FCollisionShape Shape;
+		bool bQueued = false;
+	};
+
+	FQueuedSweep Queued[NumProbes];
+	FTraceHandle Handles[NumProbes];
+	FClimbingProbeResult Results[NumProbes];
+
+	struct FResolvedProbe
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		FHitResult Hit;
+		bool bValid = false;
+	};
+
+	/** Named probes answered when the batch was queued */
+	FResolvedProbe Resolved[static_cast<int32>(EClimbingProbe::Num)];
+
+	/** Actor location of the batch in flight */
+	FVector SubmittedOrigin;
+};
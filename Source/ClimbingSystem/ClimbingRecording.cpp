@@ -0,0 +1,209 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingRecording.h"
+
+#include "ClimbingMovementComponent.h"
+#include "ClimbingSystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+const uint32 FClimbingRecordingHeader::Magic = 0x434C4D42; // CLMB
+const int32 FClimbingRecordingHeader::LatestVersion = 3;
+
+const TCHAR* ClimbingRecording::FileExtension = TEXT(".climbrec");
+
+namespace ClimbingRecording
+{
+	/** Flags of the booleans, packed in a byte. The first two were the grab and the jump of the input before version 3 */
+	enum EPackedFlags : uint8
+	{
+		AheadHit	= 1 << 2,
+		NotClimbable	= 1 << 3,
+	};
+
+	/** Custom version of the archives, set from the header so the frames can read older recordings */
+	static const FGuid VersionGuid(0x6B1F32D4, 0x0A9C4E57, 0x9E3D27B1, 0x5C84F0A2);
+}
+
+FArchive& operator<<(FArchive& Ar, FClimbingRecordedSolve& Solve)
+{
+	uint8 Flags = (Solve.bAheadHit ? ClimbingRecording::AheadHit : 0) | (Solve.bAheadClimbable ? 0 : ClimbingRecording::NotClimbable);
+	Ar << Solve.ClimbInput << Solve.Location << Solve.CapsuleRadius << Flags;
+	Solve.bAheadHit = (Flags & ClimbingRecording::AheadHit) != 0;
+	Solve.bAheadClimbable = (Flags & ClimbingRecording::NotClimbable) == 0;
+
+	// A missed probe has nothing else to tell
+	if (Solve.bAheadHit)
+	{
+		Ar << Solve.AheadLocation << Solve.AheadNormal;
+		if (Ar.CustomVer(ClimbingRecording::VersionGuid) >= 2)
+		{
+			Ar << Solve.AheadMinClimbAngle << Solve.AheadMaxClimbAngle;
+		}
+	}
+	Ar << Solve.WallNormal << Solve.Status << Solve.Direction << Solve.Rotation;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FClimbingRecordedFrame& Frame)
+{
+	const bool bHasInputAndTransform = Ar.CustomVer(ClimbingRecording::VersionGuid) < 3;
+
+	// Forward and right axes, then the grab and jump flags
+	float Axes[2];
+	uint8 InputFlags;
+	Ar << Frame.DeltaTime;
+	if (bHasInputAndTransform)
+	{
+		Ar << Axes[0] << Axes[1] << InputFlags;
+	}
+	Ar << Frame.Solves;
+
+	// Location, rotation and movement modes
+	if (bHasInputAndTransform)
+	{
+		FVector Location;
+		FRotator Rotation;
+		uint8 MovementModes[2];
+		Ar << Location << Rotation << MovementModes[0] << MovementModes[1];
+	}
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FClimbingRecordingHeader& Header)
+{
+	Ar << Header.FileMagic << Header.Version;
+	if (Header.FileMagic != FClimbingRecordingHeader::Magic || Header.Version > FClimbingRecordingHeader::LatestVersion)
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Header.MapName << Header.MinClimbAngle << Header.MaxClimbAngle << Header.MaxTurnAngle;
+	Ar.SetCustomVersion(ClimbingRecording::VersionGuid, Header.Version, TEXT("ClimbingRecording"));
+	return Ar;
+}
+
+TUniquePtr<FClimbingRecorder> FClimbingRecorder::Create(const FString& Filename, const FClimbingRecordingHeader& Header)
+{
+	FArchive* Writer = IFileManager::Get().CreateFileWriter(*Filename);
+	if (!Writer)
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Can't write the climbing recording %s"), *Filename);
+		return nullptr;
+	}
+
+	FClimbingRecordingHeader HeaderCopy = Header;
+	*Writer << HeaderCopy;
+	return TUniquePtr<FClimbingRecorder>(new FClimbingRecorder(Filename, Writer));
+}
+
+FClimbingRecorder::FClimbingRecorder(const FString& InFilename, FArchive* InWriter)
+	: Filename(InFilename)
+	, Writer(InWriter)
+	, NumFrames(0)
+{
+}
+
+FClimbingRecorder::~FClimbingRecorder()
+{
+	if (Writer)
+	{
+		Writer->Close();
+	}
+}
+
+void FClimbingRecorder::EndFrame(float DeltaTime)
+{
+	Frame.DeltaTime = DeltaTime;
+	*Writer << Frame;
+	++NumFrames;
+
+	Frame = FClimbingRecordedFrame();
+}
+
+bool ClimbingRecording::Load(const FString& Filename, FClimbingRecordingHeader& OutHeader, TArray<FClimbingRecordedFrame>& OutFrames)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader)
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Can't read the climbing recording %s"), *Filename);
+		return false;
+	}
+
+	*Reader << OutHeader;
+	if (Reader->IsError())
+	{
+		UE_LOG(LogClimbing, Error, TEXT("%s is not a climbing recording, or is from a newer version"), *Filename);
+		return false;
+	}
+
+	OutFrames.Reset();
+	while (!Reader->AtEnd() && !Reader->IsError())
+	{
+		*Reader << OutFrames.AddDefaulted_GetRef();
+	}
+
+	// The last frame can be cut short if the recording did not end cleanly
+	if (Reader->IsError() && OutFrames.Num() > 0)
+	{
+		OutFrames.Pop();
+	}
+
+	// Solves of version 1 were checked against the angles of the climber
+	if (OutHeader.Version < 2)
+	{
+		for (FClimbingRecordedFrame& Frame : OutFrames)
+		{
+			for (FClimbingRecordedSolve& Solve : Frame.Solves)
+			{
+				Solve.AheadMinClimbAngle = OutHeader.MinClimbAngle;
+				Solve.AheadMaxClimbAngle = OutHeader.MaxClimbAngle;
+			}
+		}
+	}
+	return true;
+}
+
+namespace ClimbingRecording
+{
+	static UClimbingMovementComponent* GetLocalClimber(UWorld* World)
+	{
+		const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		const ACharacter* Character = PlayerController ? Cast<ACharacter>(PlayerController->GetPawn()) : nullptr;
+		return Character ? Cast<UClimbingMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs RecordCommand(
+		TEXT("climbing.Record"),
+		TEXT("Records the probe hits and surface solves of the local player. Optional argument: file name"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			UClimbingMovementComponent* Climber = GetLocalClimber(World);
+			if (!Climber)
+			{
+				UE_LOG(LogClimbing, Warning, TEXT("climbing.Record: no local climbing character"));
+				return;
+			}
+
+			const FString Filename = Args.Num() > 0 ? Args[0] :
+				FPaths::ProjectSavedDir() / TEXT("Climbing") / FDateTime::Now().ToString() + FileExtension;
+			Climber->StartRecording(Filename);
+		}));
+
+	static FAutoConsoleCommandWithWorld StopRecordCommand(
+		TEXT("climbing.StopRecord"),
+		TEXT("Stops the recording started with climbing.Record"),
+		FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+		{
+			if (UClimbingMovementComponent* Climber = GetLocalClimber(World))
+			{
+				Climber->StopRecording();
+			}
+		}));
+}
@@ -0,0 +1,102 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A climbing step: the probe hits the surface solve was given and the pose it decided */
+struct FClimbingRecordedSolve
+{
+	FVector2D ClimbInput = FVector2D::ZeroVector;
+	FVector Location = FVector::ZeroVector;
+	float CapsuleRadius = 0.f;
+	bool bAheadHit = false;
+	FVector AheadLocation = FVector::ZeroVector;
+	FVector AheadNormal = FVector::ZeroVector;
+	FVector WallNormal = FVector::ZeroVector;
+
+	/** Climbing rules of the wall ahead, from version 2. Older recordings use the angles of the header */
+	bool bAheadClimbable = true;
+	float AheadMinClimbAngle = 0.f;
+	float AheadMaxClimbAngle = 0.f;
+
+	/** EClimbingSolveStatus */
+	uint8 Status = 0;
+	FVector Direction = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	friend FArchive& operator<<(FArchive& Ar, FClimbingRecordedSolve& Solve);
+};
+
+/**
+ * Everything recorded for a frame of a climber. Only the solves are replayed: the input and the transform
+ * of the frame come from the movement and physics around them, recordings before version 3 still have them
+ * and they are skipped on load
+ */
+struct FClimbingRecordedFrame
+{
+	float DeltaTime = 0.f;
+
+	/** Solves of the climbing steps of the frame, none while not climbing */
+	TArray<FClimbingRecordedSolve> Solves;
+
+	friend FArchive& operator<<(FArchive& Ar, FClimbingRecordedFrame& Frame);
+};
+
+/** Angle rules of the climber, replays are solved with the settings they were recorded with */
+struct FClimbingRecordingHeader
+{
+	static const uint32 Magic;
+	static const int32 LatestVersion;
+
+	uint32 FileMagic = Magic;
+	int32 Version = LatestVersion;
+	FString MapName;
+	float MinClimbAngle = 0.f;
+	float MaxClimbAngle = 0.f;
+	float MaxTurnAngle = 0.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FClimbingRecordingHeader& Header);
+};
+
+/**
+ * Streams the frames of a climber to a binary file, written as they end so a crash keeps what came before.
+ * The file is a FClimbingRecordingHeader followed by FClimbingRecordedFrame until the end of the file.
+ */
+class FClimbingRecorder
+{
+public:
+	/** Opens the file and writes the header
+	 *  @return Null if the file can't be written
+	 */
+	static TUniquePtr<FClimbingRecorder> Create(const FString& Filename, const FClimbingRecordingHeader& Header);
+
+	~FClimbingRecorder();
+
+	void RecordSolve(const FClimbingRecordedSolve& Solve) { Frame.Solves.Add(Solve); }
+
+	/** Writes the frame and starts the next one */
+	void EndFrame(float DeltaTime);
+
+	const FString& GetFilename() const { return Filename; }
+	int32 GetNumFrames() const { return NumFrames; }
+
+private:
+	FClimbingRecorder(const FString& InFilename, FArchive* InWriter);
+
+	FString Filename;
+	TUniquePtr<FArchive> Writer;
+	FClimbingRecordedFrame Frame;
+	int32 NumFrames;
+};
+
+namespace ClimbingRecording
+{
+	/** Extension of the recordings, saved in Saved/Climbing by default */
+	extern const TCHAR* FileExtension;
+
+	/** Reads a whole recording
+	 *  @return False if the file is missing, not a recording or from an unknown version
+	 */
+	bool Load(const FString& Filename, FClimbingRecordingHeader& OutHeader, TArray<FClimbingRecordedFrame>& OutFrames);
+}
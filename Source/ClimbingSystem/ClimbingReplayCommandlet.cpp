@@ -0,0 +1,232 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingReplayCommandlet.h"
+
+#include "ClimbingMovementComponent.h"
+#include "ClimbingRecording.h"
+#include "ClimbingSolver.h"
+#include "ClimbingSystem.h"
+
+namespace ClimbingReplay
+{
+	/** Probe hits the recorded solve was given, with the rules of the wall ahead it was checked against */
+	static FClimbingSolveInput MakeInput(const FClimbingRecordedSolve& Solve)
+	{
+		FClimbingSolveInput Input;
+		Input.Location = Solve.Location;
+		Input.CapsuleRadius = Solve.CapsuleRadius;
+		Input.bAheadHit = Solve.bAheadHit;
+		Input.AheadLocation = Solve.AheadLocation;
+		Input.AheadNormal = Solve.AheadNormal;
+		Input.AheadRules.bClimbable = Solve.bAheadClimbable;
+		Input.AheadRules.MinClimbAngle = Solve.AheadMinClimbAngle;
+		Input.AheadRules.MaxClimbAngle = Solve.AheadMaxClimbAngle;
+		Input.WallNormal = Solve.WallNormal;
+		return Input;
+	}
+
+	/** Climbing steps on random walls around random climbers. Most of them can be climbed, the rest fail every
+	 *  check of the solve in turn: no wall, not climbable, turn too sharp and climb angle out of the rules */
+	static void MakeSyntheticInputs(int32 NumSteps, int32 Seed, const FClimbingSurfaceRules& Rules, TArray<FClimbingSolveInput>& OutInputs)
+	{
+		FRandomStream Random(Seed);
+		OutInputs.SetNum(NumSteps);
+		for (FClimbingSolveInput& Input : OutInputs)
+		{
+			// Facing the wall ahead, pitched a little past the climb angles of the rules
+			const FVector Facing = FRotator(Random.FRandRange(Rules.MinClimbAngle - 15.f, Rules.MaxClimbAngle + 15.f), Random.FRandRange(-180.f, 180.f), 0.f).Vector();
+			Input.Location = Random.GetUnitVector() * Random.FRandRange(0.f, 10000.f);
+			Input.CapsuleRadius = 42.f;
+			Input.bAheadHit = Random.FRand() > 0.05f;
+			Input.AheadLocation = Input.Location + Facing * (Input.CapsuleRadius + Random.FRandRange(0.f, 20.f));
+			Input.AheadNormal = -Facing;
+			Input.AheadRules = Rules;
+			Input.AheadRules.bClimbable = Random.FRand() > 0.05f;
+
+			// The wall in front of the climber turns into the one ahead, sometimes by more than MaxTurnAngle
+			Input.WallNormal = FRotator(0.f, Random.FRandRange(-90.f, 90.f), 0.f).RotateVector(Input.AheadNormal);
+		}
+	}
+
+	/** Times the solve of the inputs one step at a time, then as a single batch of climbers */
+	static void TimeSolves(const FClimbingSolverSettings& Settings, const TArray<FClimbingSolveInput>& Inputs, int32 NumIterations)
+	{
+		// Results go to a sink, so the solve can't be optimized away
+		uint32 Sink = 0;
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (const FClimbingSolveInput& Input : Inputs)
+			{
+				FVector Direction;
+				FRotator Rotation;
+				Sink += static_cast<uint32>(FClimbingSolver::Solve(Settings, Input, Direction, Rotation));
+			}
+		}
+		const double SingleMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+
+		// Every step as a climber of a single batch, as the subsystem solves them
+		TArray<FClimbingSolverSettings> BatchSettings;
+		BatchSettings.Init(Settings, Inputs.Num());
+		TArray<FClimbingSolveOutput> Outputs;
+		Outputs.SetNum(Inputs.Num());
+		StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			FClimbingSolver::SolveBatch(BatchSettings, Inputs, Outputs);
+			Sink += Outputs.Num() > 0 ? static_cast<uint32>(Outputs.Last().Status) : 0;
+		}
+		const double BatchMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+		const int32 NumSolves = Inputs.Num();
+		const int32 NumTimedSolves = NumSolves * NumIterations;
+
+		UE_LOG(LogClimbing, Display, TEXT("Climbing replay: %d solves in %.1f us, %.4f us per solve"),
+		       NumTimedSolves, SingleMicroseconds, NumTimedSolves > 0 ? SingleMicroseconds / NumTimedSolves : 0.0);
+		UE_LOG(LogClimbing, Display, TEXT("Climbing replay: %d batches of %d climbers in %.1f us, %.4f us per climber (%u)"),
+		       NumIterations, NumSolves, BatchMicroseconds, NumTimedSolves > 0 ? BatchMicroseconds / NumTimedSolves : 0.0, Sink);
+	}
+}
+
+UClimbingReplayCommandlet::UClimbingReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UClimbingReplayCommandlet::Main(const FString& Params)
+{
+	FString Mode = TEXT("Verify");
+	FParse::Value(*Params, TEXT("Mode="), Mode);
+
+	int32 NumIterations = 100;
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	// Without a recording, the solve is timed on generated steps checked against the default rules of the climber
+	int32 NumSyntheticSteps = 0;
+	if (FParse::Value(*Params, TEXT("Synthetic="), NumSyntheticSteps))
+	{
+		if (Mode != TEXT("Time") || NumSyntheticSteps <= 0)
+		{
+			UE_LOG(LogClimbing, Error, TEXT("Climbing replay: -Synthetic=<steps> needs -Mode=Time and at least one step"));
+			return 1;
+		}
+
+		int32 Seed = 0;
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+
+		const UClimbingMovementComponent* Defaults = GetDefault<UClimbingMovementComponent>();
+		FClimbingSolverSettings Settings;
+		Settings.MaxTurnAngle = Defaults->MaxTurnAngle;
+		FClimbingSurfaceRules Rules;
+		Rules.MinClimbAngle = Defaults->MinClimbAngle;
+		Rules.MaxClimbAngle = Defaults->MaxClimbAngle;
+
+		TArray<FClimbingSolveInput> Inputs;
+		ClimbingReplay::MakeSyntheticInputs(NumSyntheticSteps, Seed, Rules, Inputs);
+
+		int32 NumMoves = 0;
+		for (const FClimbingSolveInput& Input : Inputs)
+		{
+			FClimbingSolveOutput Output;
+			FClimbingSolver::Solve(Settings, Input, Output);
+			NumMoves += Output.Status == EClimbingSolveStatus::Move ? 1 : 0;
+		}
+		UE_LOG(LogClimbing, Display, TEXT("Climbing replay: %d synthetic steps (seed %d), %d of them move"), Inputs.Num(), Seed, NumMoves);
+
+		ClimbingReplay::TimeSolves(Settings, Inputs, NumIterations);
+		return 0;
+	}
+
+	FString Filename;
+	if (!FParse::Value(*Params, TEXT("File="), Filename))
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing replay: missing -File=<recording> or -Synthetic=<steps>"));
+		return 1;
+	}
+
+	FClimbingRecordingHeader Header;
+	TArray<FClimbingRecordedFrame> Frames;
+	if (!ClimbingRecording::Load(Filename, Header, Frames))
+	{
+		return 1;
+	}
+
+	using ClimbingReplay::MakeInput;
+	using ClimbingReplay::TimeSolves;
+
+	// MaxTurnAngle comes with the header, the climb angles with each recorded solve
+	FClimbingSolverSettings Settings;
+	Settings.MaxTurnAngle = Header.MaxTurnAngle;
+
+	int32 NumSolves = 0;
+	float Duration = 0.f;
+	for (const FClimbingRecordedFrame& Frame : Frames)
+	{
+		NumSolves += Frame.Solves.Num();
+		Duration += Frame.DeltaTime;
+	}
+	UE_LOG(LogClimbing, Display, TEXT("Climbing replay of %s (%s): %d frames over %.1f s, %d solves"),
+	       *Filename, *Header.MapName, Frames.Num(), Duration, NumSolves);
+
+	if (Mode == TEXT("Time"))
+	{
+		// The inputs are built up front, only the solve is timed
+		TArray<FClimbingSolveInput> Inputs;
+		Inputs.Reserve(NumSolves);
+		for (const FClimbingRecordedFrame& Frame : Frames)
+		{
+			for (const FClimbingRecordedSolve& Solve : Frame.Solves)
+			{
+				Inputs.Add(MakeInput(Solve));
+			}
+		}
+
+		TimeSolves(Settings, Inputs, NumIterations);
+		return 0;
+	}
+
+	if (Mode != TEXT("Verify"))
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing replay: unknown mode %s, use Verify or Time"), *Mode);
+		return 1;
+	}
+
+	int32 NumMismatches = 0;
+	for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); ++FrameIndex)
+	{
+		for (const FClimbingRecordedSolve& Solve : Frames[FrameIndex].Solves)
+		{
+			FVector Direction = FVector::ZeroVector;
+			FRotator Rotation = FRotator::ZeroRotator;
+			const EClimbingSolveStatus Status = FClimbingSolver::Solve(Settings, MakeInput(Solve), Direction, Rotation);
+			const bool bMove = Status == EClimbingSolveStatus::Move;
+
+			// Bit for bit: any change of the decision code shows up, even below the tolerance of Equals()
+			const bool bSame = static_cast<uint8>(Status) == Solve.Status &&
+				(!bMove || (FMemory::Memcmp(&Direction, &Solve.Direction, sizeof(FVector)) == 0 &&
+				            FMemory::Memcmp(&Rotation, &Solve.Rotation, sizeof(FRotator)) == 0));
+			if (!bSame)
+			{
+				if (NumMismatches == 0)
+				{
+					UE_LOG(LogClimbing, Error, TEXT("Climbing replay: frame %d solved to status %d direction %s rotation %s, recorded %d %s %s"),
+					       FrameIndex, static_cast<int32>(Status), *Direction.ToString(), *Rotation.ToString(),
+					       static_cast<int32>(Solve.Status), *Solve.Direction.ToString(), *Solve.Rotation.ToString());
+				}
+				++NumMismatches;
+			}
+		}
+	}
+
+	if (NumMismatches > 0)
+	{
+		UE_LOG(LogClimbing, Error, TEXT("Climbing replay: %d of %d solves differ from the recording"), NumMismatches, NumSolves);
+		return 1;
+	}
+
+	UE_LOG(LogClimbing, Display, TEXT("Climbing replay: all %d solves match the recording"), NumSolves);
+	return 0;
+}
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbingReplayCommandlet.generated.h"
+
+/**
+ * Feeds a climbing recording back into the surface solve, without a world or physics. The probe hits of
+ * every recorded step go through the solve again: Verify checks that it decides the same pose, bit for bit,
+ * and Time measures the solve alone, one step at a time and as a batch of every recorded step. Without a
+ * recording, Time can run on random steps instead.
+ * Only FClimbingSolver is replayed, the probes and the movement around it need the world they were recorded in.
+ *
+ * UE4Editor-Cmd ClimbingSystem.uproject -run=ClimbingReplay -File=<recording> [-Mode=Verify|Time] [-Iterations=<passes>]
+ * UE4Editor-Cmd ClimbingSystem.uproject -run=ClimbingReplay -Mode=Time -Synthetic=<steps> [-Seed=<seed>] [-Iterations=<passes>]
+ */
+UCLASS()
+class UClimbingReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingReplayCommandlet();
+
+	//Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//End UCommandlet Interface
+};
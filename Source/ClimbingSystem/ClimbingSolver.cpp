@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingSolver.h"
+
+EClimbingSolveStatus FClimbingSolver::Solve(const FClimbingSolverSettings& Settings, const FClimbingSolveInput& Input, FVector& OutDirection, FRotator& OutRotation)
+{
+	if (!Input.bAheadHit)
+	{
+		return EClimbingSolveStatus::NoWall;
+	}
+
+	if (!Input.AheadRules.bClimbable)
+	{
+		return EClimbingSolveStatus::NotClimbable;
+	}
+
+	// The angle between the wall in front of the character, and the wall in the direction the
+	// character is moving: if this is higher than MaxTurnAngle, movement is stopped
+	const float TurnAngle = GetTurnAngle(Input.AheadNormal, Input.WallNormal);
+
+	// Check for lateral movement maximum angle
+	if (TurnAngle > Settings.MaxTurnAngle)
+	{
+		return EClimbingSolveStatus::TurnTooSharp;
+	}
+
+	OutRotation = (-Input.AheadNormal).Rotation();
+	const float ClimbAngle = OutRotation.Pitch;
+
+	if (ClimbAngle > Input.AheadRules.MaxClimbAngle || ClimbAngle < Input.AheadRules.MinClimbAngle)
+	{
+		return EClimbingSolveStatus::InvalidClimbAngle;
+	}
+
+	// Finally movement and rotation can be applied
+	OutDirection = (Input.AheadNormal * Input.CapsuleRadius + Input.AheadLocation - Input.Location).GetSafeNormal();
+	return EClimbingSolveStatus::Move;
+}
+
+void FClimbingSolver::Solve(const FClimbingSolverSettings& Settings, const FClimbingSolveInput& Input, FClimbingSolveOutput& OutOutput)
+{
+	OutOutput.Direction = FVector::ZeroVector;
+	OutOutput.Rotation = FRotator::ZeroRotator;
+	OutOutput.Status = Solve(Settings, Input, OutOutput.Direction, OutOutput.Rotation);
+}
+
+void FClimbingSolver::SolveBatch(TArrayView<const FClimbingSolverSettings> Settings, TArrayView<const FClimbingSolveInput> Inputs, TArrayView<FClimbingSolveOutput> OutOutputs)
+{
+	check(Settings.Num() == Inputs.Num() && Inputs.Num() == OutOutputs.Num());
+	for (int32 Index = 0; Index < Inputs.Num(); ++Index)
+	{
+		Solve(Settings[Index], Inputs[Index], OutOutputs[Index]);
+	}
+}
+
+float FClimbingSolver::GetTurnAngle(const FVector& WallNormal, const FVector& OtherWallNormal)
+{
+	const float CosAngle = FVector::DotProduct(WallNormal.GetSafeNormal(), OtherWallNormal.GetSafeNormal());
+	return FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(CosAngle, -1.f, 1.f)));
+}
+
+float FClimbingSolver::GetClimbAngle(const FVector& WallNormal)
+{
+	return (-WallNormal).Rotation().Pitch;
+}
+
+FRotator FClimbingSolver::InterpRotation(const FRotator& Current, const FRotator& Target, float DeltaTime, float InterpSpeed)
+{
+	return FMath::RInterpTo(Current, Target, DeltaTime, InterpSpeed);
+}
+
+bool FClimbingSolver::IsVaultInput(const FVector2D& ClimbInput)
+{
+	return ClimbInput.Y > 0.f;
+}
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Outcome of the climbing surface solve */
+enum class EClimbingSolveStatus : uint8
+{
+	/** The character can move towards the wall in the direction of the input */
+	Move,
+	/** There is no wall in the direction of the input, the character may vault */
+	NoWall,
+	/** The wall in the direction of the input turns by more than MaxTurnAngle */
+	TurnTooSharp,
+	/** The climb angle of the wall is out of MinClimbAngle and MaxClimbAngle */
+	InvalidClimbAngle,
+	/** The physical material of the wall in the direction of the input can't be climbed */
+	NotClimbable,
+};
+
+/** Climbing rules of a surface, the ones of the climber unless its physical material changes them */
+struct FClimbingSurfaceRules
+{
+	bool bClimbable = true;
+	float SpeedScale = 1.f;
+	float MinClimbAngle = 0.f;
+	float MaxClimbAngle = 0.f;
+};
+
+/** Settings of a climber the solve checks against */
+struct FClimbingSolverSettings
+{
+	float MaxTurnAngle = 0.f;
+};
+
+/** What the probes of a climbing step found, in world space */
+struct FClimbingSolveInput
+{
+	/** Pose of the climber */
+	FVector Location = FVector::ZeroVector;
+	float CapsuleRadius = 0.f;
+
+	/** Wall in the direction of the input and its rules */
+	bool bAheadHit = false;
+	FVector AheadLocation = FVector::ZeroVector;
+	FVector AheadNormal = FVector::ZeroVector;
+	FClimbingSurfaceRules AheadRules;
+
+	/** Normal of the wall in front of the climber, zero if the probe missed */
+	FVector WallNormal = FVector::ZeroVector;
+};
+
+/** Pose and decision of a climbing step */
+struct FClimbingSolveOutput
+{
+	EClimbingSolveStatus Status = EClimbingSolveStatus::NoWall;
+
+	/** Direction to move in and rotation to face the wall ahead with, zero unless the status is Move.
+	 *  The rotation is also set with InvalidClimbAngle, its pitch is the angle that was rejected */
+	FVector Direction = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+};
+
+/**
+ * Decision logic of a climbing step on plain data: the turn and climb angle checks, the direction to the wall
+ * ahead and the rotation facing it. Knows nothing of the world or the components, so the movement, the batch
+ * of the subsystem and the replay commandlet all solve the same way, and the solve can be timed on its own.
+ */
+class FClimbingSolver
+{
+public:
+	static EClimbingSolveStatus Solve(const FClimbingSolverSettings& Settings, const FClimbingSolveInput& Input, FVector& OutDirection, FRotator& OutRotation);
+
+	static void Solve(const FClimbingSolverSettings& Settings, const FClimbingSolveInput& Input, FClimbingSolveOutput& OutOutput);
+
+	/** Solves many climbers, the three arrays have the same size and the same index is the same climber */
+	static void SolveBatch(TArrayView<const FClimbingSolverSettings> Settings, TArrayView<const FClimbingSolveInput> Inputs, TArrayView<FClimbingSolveOutput> OutOutputs);
+
+	/** Angle in degrees between two walls, checked against MaxTurnAngle */
+	static float GetTurnAngle(const FVector& WallNormal, const FVector& OtherWallNormal);
+
+	/** Pitch of a character facing a wall, checked against MinClimbAngle and MaxClimbAngle */
+	static float GetClimbAngle(const FVector& WallNormal);
+
+	/** Rotation of the character turning to face the wall over a step */
+	static FRotator InterpRotation(const FRotator& Current, const FRotator& Target, float DeltaTime, float InterpSpeed);
+
+	/** Does running out of wall with this input mean the top was reached, so the character may vault? */
+	static bool IsVaultInput(const FVector2D& ClimbInput);
+};
@@ -0,0 +1,210 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingSolver.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbingSolverTest
+{
+	static constexpr int32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	static FClimbingSolverSettings MakeSettings()
+	{
+		FClimbingSolverSettings Settings;
+		Settings.MaxTurnAngle = 65.f;
+		return Settings;
+	}
+
+	/** A climber facing a flat vertical wall along +X, with the default rules of the climber */
+	static FClimbingSolveInput MakeFlatWallInput()
+	{
+		FClimbingSolveInput Input;
+		Input.Location = FVector(0.f, 0.f, 100.f);
+		Input.CapsuleRadius = 40.f;
+		Input.bAheadHit = true;
+		Input.AheadLocation = FVector(50.f, 20.f, 100.f);
+		Input.AheadNormal = FVector(-1.f, 0.f, 0.f);
+		Input.AheadRules.MinClimbAngle = -75.f;
+		Input.AheadRules.MaxClimbAngle = 45.f;
+		Input.WallNormal = FVector(-1.f, 0.f, 0.f);
+		return Input;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingSolverMoveTest, "ClimbingSystem.Solver.Move", ClimbingSolverTest::TestFlags)
+
+bool FClimbingSolverMoveTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingSolverTest;
+
+	FClimbingSolveOutput Output;
+	FClimbingSolver::Solve(MakeSettings(), MakeFlatWallInput(), Output);
+	TestEqual(TEXT("Status"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::Move));
+
+	// Towards the point a capsule radius off the wall ahead, facing the wall
+	TestEqual(TEXT("Direction"), Output.Direction, FVector(10.f, 20.f, 0.f).GetSafeNormal(), KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Rotation"), Output.Rotation.Equals(FRotator::ZeroRotator, KINDA_SMALL_NUMBER));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingSolverFailureTest, "ClimbingSystem.Solver.FailureStatuses", ClimbingSolverTest::TestFlags)
+
+bool FClimbingSolverFailureTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingSolverTest;
+
+	const FClimbingSolverSettings Settings = MakeSettings();
+	FClimbingSolveOutput Output;
+
+	FClimbingSolveInput NoWall = MakeFlatWallInput();
+	NoWall.bAheadHit = false;
+	FClimbingSolver::Solve(Settings, NoWall, Output);
+	TestEqual(TEXT("No wall ahead"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::NoWall));
+	TestTrue(TEXT("No direction without a wall"), Output.Direction.IsZero());
+
+	FClimbingSolveInput NotClimbable = MakeFlatWallInput();
+	NotClimbable.AheadRules.bClimbable = false;
+	FClimbingSolver::Solve(Settings, NotClimbable, Output);
+	TestEqual(TEXT("Wall not climbable"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::NotClimbable));
+
+	// An outside corner of 90 degrees, over MaxTurnAngle
+	FClimbingSolveInput Corner = MakeFlatWallInput();
+	Corner.AheadNormal = FVector(0.f, 1.f, 0.f);
+	FClimbingSolver::Solve(Settings, Corner, Output);
+	TestEqual(TEXT("Turn too sharp"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::TurnTooSharp));
+	TestTrue(TEXT("No direction on a sharp turn"), Output.Direction.IsZero());
+
+	// The same corner under a wider MaxTurnAngle
+	FClimbingSolverSettings WideSettings = Settings;
+	WideSettings.MaxTurnAngle = 95.f;
+	FClimbingSolver::Solve(WideSettings, Corner, Output);
+	TestEqual(TEXT("Turn within MaxTurnAngle"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::Move));
+
+	// An overhang steeper than MaxClimbAngle, the rejected pitch comes with the rotation
+	FClimbingSolveInput Overhang = MakeFlatWallInput();
+	Overhang.AheadNormal = FVector(-0.3f, 0.f, -1.f).GetSafeNormal();
+	Overhang.WallNormal = Overhang.AheadNormal;
+	FClimbingSolver::Solve(Settings, Overhang, Output);
+	TestEqual(TEXT("Climb angle over the max"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::InvalidClimbAngle));
+	TestTrue(TEXT("Rejected pitch"), Output.Rotation.Pitch > Overhang.AheadRules.MaxClimbAngle);
+	TestTrue(TEXT("No direction on an invalid angle"), Output.Direction.IsZero());
+
+	// A slope too flat to climb, under MinClimbAngle
+	FClimbingSolveInput Slope = MakeFlatWallInput();
+	Slope.AheadNormal = FVector(-0.1f, 0.f, 1.f).GetSafeNormal();
+	Slope.WallNormal = Slope.AheadNormal;
+	FClimbingSolver::Solve(Settings, Slope, Output);
+	TestEqual(TEXT("Climb angle under the min"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::InvalidClimbAngle));
+
+	// The checks run in order: a wall that can't be climbed is reported before its turn
+	FClimbingSolveInput NotClimbableCorner = Corner;
+	NotClimbableCorner.AheadRules.bClimbable = false;
+	FClimbingSolver::Solve(Settings, NotClimbableCorner, Output);
+	TestEqual(TEXT("Climbable is checked first"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::NotClimbable));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingSolverCornerTest, "ClimbingSystem.Solver.InsideCorners", ClimbingSolverTest::TestFlags)
+
+bool FClimbingSolverCornerTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingSolverTest;
+
+	const FClimbingSolverSettings Settings = MakeSettings();
+	FClimbingSolveOutput Output;
+
+	// Moving right into a wall that turns 45 degrees towards the climber
+	FClimbingSolveInput Corner = MakeFlatWallInput();
+	Corner.AheadLocation = FVector(30.f, 60.f, 100.f);
+	Corner.AheadNormal = FVector(-1.f, -1.f, 0.f).GetSafeNormal();
+	FClimbingSolver::Solve(Settings, Corner, Output);
+	TestEqual(TEXT("Status"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::Move));
+	TestEqual(TEXT("Turns to face the wall ahead"), Output.Rotation.Yaw, 45.f, 0.01f);
+	TestEqual(TEXT("No pitch on a vertical corner"), Output.Rotation.Pitch, 0.f, 0.01f);
+
+	// Towards the point a capsule radius off the wall ahead, along the corner
+	const FVector Target = Corner.AheadLocation + Corner.AheadNormal * Corner.CapsuleRadius;
+	TestEqual(TEXT("Direction"), Output.Direction, (Target - Corner.Location).GetSafeNormal(), KINDA_SMALL_NUMBER);
+	TestTrue(TEXT("Keeps moving right"), Output.Direction.Y > 0.f);
+
+	// A square inside corner turns as much as a square outside one
+	FClimbingSolveInput SquareCorner = Corner;
+	SquareCorner.AheadNormal = FVector(0.f, -1.f, 0.f);
+	FClimbingSolver::Solve(Settings, SquareCorner, Output);
+	TestEqual(TEXT("Square inside corner"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::TurnTooSharp));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingSolverLimitsTest, "ClimbingSystem.Solver.AngleLimits", ClimbingSolverTest::TestFlags)
+
+bool FClimbingSolverLimitsTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingSolverTest;
+
+	FClimbingSolveOutput Output;
+
+	// A turn of exactly MaxTurnAngle is allowed, anything over it is not
+	FClimbingSolveInput Corner = MakeFlatWallInput();
+	Corner.AheadNormal = FVector(-1.f, 1.f, 0.f).GetSafeNormal();
+	FClimbingSolverSettings Settings = MakeSettings();
+	Settings.MaxTurnAngle = FClimbingSolver::GetTurnAngle(Corner.AheadNormal, Corner.WallNormal);
+	FClimbingSolver::Solve(Settings, Corner, Output);
+	TestEqual(TEXT("Turn at MaxTurnAngle"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::Move));
+
+	Settings.MaxTurnAngle -= 0.01f;
+	FClimbingSolver::Solve(Settings, Corner, Output);
+	TestEqual(TEXT("Turn over MaxTurnAngle"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::TurnTooSharp));
+
+	// The same for the climb angle, at both ends of the rules
+	Settings = MakeSettings();
+	FClimbingSolveInput Overhang = MakeFlatWallInput();
+	Overhang.AheadNormal = FVector(-1.f, 0.f, -1.f).GetSafeNormal();
+	Overhang.WallNormal = Overhang.AheadNormal;
+	Overhang.AheadRules.MaxClimbAngle = FClimbingSolver::GetClimbAngle(Overhang.AheadNormal);
+	FClimbingSolver::Solve(Settings, Overhang, Output);
+	TestEqual(TEXT("Climb angle at MaxClimbAngle"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::Move));
+
+	Overhang.AheadRules.MaxClimbAngle -= 0.01f;
+	FClimbingSolver::Solve(Settings, Overhang, Output);
+	TestEqual(TEXT("Climb angle over MaxClimbAngle"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::InvalidClimbAngle));
+
+	FClimbingSolveInput Slope = MakeFlatWallInput();
+	Slope.AheadNormal = FVector(-1.f, 0.f, 1.f).GetSafeNormal();
+	Slope.WallNormal = Slope.AheadNormal;
+	Slope.AheadRules.MinClimbAngle = FClimbingSolver::GetClimbAngle(Slope.AheadNormal);
+	FClimbingSolver::Solve(Settings, Slope, Output);
+	TestEqual(TEXT("Climb angle at MinClimbAngle"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::Move));
+
+	Slope.AheadRules.MinClimbAngle += 0.01f;
+	FClimbingSolver::Solve(Settings, Slope, Output);
+	TestEqual(TEXT("Climb angle under MinClimbAngle"), static_cast<int32>(Output.Status), static_cast<int32>(EClimbingSolveStatus::InvalidClimbAngle));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingSolverAnglesTest, "ClimbingSystem.Solver.Angles", ClimbingSolverTest::TestFlags)
+
+bool FClimbingSolverAnglesTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Same wall"), FClimbingSolver::GetTurnAngle(FVector(-1.f, 0.f, 0.f), FVector(-2.f, 0.f, 0.f)), 0.f, 0.01f);
+	TestEqual(TEXT("Outside corner"), FClimbingSolver::GetTurnAngle(FVector(-1.f, 0.f, 0.f), FVector(0.f, 1.f, 0.f)), 90.f, 0.01f);
+	TestEqual(TEXT("Vertical wall"), FClimbingSolver::GetClimbAngle(FVector(-1.f, 0.f, 0.f)), 0.f, 0.01f);
+	TestEqual(TEXT("Overhang"), FClimbingSolver::GetClimbAngle(FVector(-1.f, 0.f, -1.f).GetSafeNormal()), 45.f, 0.01f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingSolverVaultInputTest, "ClimbingSystem.Solver.VaultInput", ClimbingSolverTest::TestFlags)
+
+bool FClimbingSolverVaultInputTest::RunTest(const FString& Parameters)
+{
+	TestTrue(TEXT("Vault when climbing up"), FClimbingSolver::IsVaultInput(FVector2D(0.f, 1.f)));
+	TestTrue(TEXT("Vault with the least input up"), FClimbingSolver::IsVaultInput(FVector2D(0.f, SMALL_NUMBER)));
+	TestTrue(TEXT("Vault when climbing up and sideways"), FClimbingSolver::IsVaultInput(FVector2D(1.f, 0.1f)));
+	TestFalse(TEXT("No vault when moving sideways"), FClimbingSolver::IsVaultInput(FVector2D(1.f, 0.f)));
+	TestFalse(TEXT("No vault without input"), FClimbingSolver::IsVaultInput(FVector2D::ZeroVector));
+	TestFalse(TEXT("No vault when climbing down"), FClimbingSolver::IsVaultInput(FVector2D(0.f, -1.f)));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingStats.h"
+
+DEFINE_STAT(STAT_ClimbingAttach);
+DEFINE_STAT(STAT_ClimbingPhys);
+DEFINE_STAT(STAT_ClimbingSolve);
+DEFINE_STAT(STAT_ClimbingVaultCheck);
+DEFINE_STAT(STAT_ClimbingSubmitProbes);
+DEFINE_STAT(STAT_ClimbingBatchSolve);
+DEFINE_STAT(STAT_ClimbingBatchSubmit);
+DEFINE_STAT(STAT_ClimbingLimbTraces);
+DEFINE_STAT(STAT_ClimbingLimbIK);
+DEFINE_STAT(STAT_ClimbingNavLinks);
+DEFINE_STAT(STAT_ClimbingHang);
+DEFINE_STAT(STAT_ClimbingLedgeScan);
+DEFINE_STAT(STAT_ClimbingBasedMovement);
+
+DEFINE_STAT(STAT_ClimbingSweeps);
+DEFINE_STAT(STAT_ClimbingCacheHits);
+DEFINE_STAT(STAT_ClimbingCacheMisses);
+DEFINE_STAT(STAT_ClimbingIndexHits);
+DEFINE_STAT(STAT_ClimbingLandscapeHits);
+DEFINE_STAT(STAT_ClimbingLedgeLookaheadVaults);
+DEFINE_STAT(STAT_ClimbingDeferredClimbers);
+
+CSV_DEFINE_CATEGORY(Climbing, true);
+
+UE_TRACE_CHANNEL_DEFINE(ClimbingChannel);
+
+#if !UE_BUILD_SHIPPING
+/** Nesting of the climbing scopes, only the outermost one is timed */
+static int32 GClimbingScopeDepth = 0;
+
+FClimbingFrameCounters& FClimbingFrameCounters::Get()
+{
+	static FClimbingFrameCounters Counters;
+	return Counters;
+}
+
+FClimbingScopeTimer::FClimbingScopeTimer()
+	: StartCycles(0)
+	, bOutermost(false)
+{
+	if (IsInGameThread())
+	{
+		bOutermost = GClimbingScopeDepth++ == 0;
+		StartCycles = bOutermost ? FPlatformTime::Cycles64() : 0;
+	}
+}
+
+FClimbingScopeTimer::~FClimbingScopeTimer()
+{
+	if (IsInGameThread())
+	{
+		if (bOutermost)
+		{
+			FClimbingFrameCounters::Get().Cycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+		--GClimbingScopeDepth;
+	}
+}
+#endif
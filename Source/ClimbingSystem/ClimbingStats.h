@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+DECLARE_STATS_GROUP(TEXT("Climbing"), STATGROUP_Climbing, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attach"), STAT_ClimbingAttach, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Phys Climbing"), STAT_ClimbingPhys, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Movement Solve"), STAT_ClimbingSolve, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Vault Check"), STAT_ClimbingVaultCheck, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Submit Probes"), STAT_ClimbingSubmitProbes, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Solve"), STAT_ClimbingBatchSolve, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Submit"), STAT_ClimbingBatchSubmit, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Limb Traces"), STAT_ClimbingLimbTraces, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Limb IK"), STAT_ClimbingLimbIK, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Nav Link Generation"), STAT_ClimbingNavLinks, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hang"), STAT_ClimbingHang, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ledge Edge Scan"), STAT_ClimbingLedgeScan, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Based Movement"), STAT_ClimbingBasedMovement, STATGROUP_Climbing, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sweeps Issued"), STAT_ClimbingSweeps, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Cache Hits"), STAT_ClimbingCacheHits, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Cache Misses"), STAT_ClimbingCacheMisses, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Index Hits"), STAT_ClimbingIndexHits, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Landscape Samples"), STAT_ClimbingLandscapeHits, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Vaults From Ledge Lookahead"), STAT_ClimbingLedgeLookaheadVaults, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climbers Over Probe Budget"), STAT_ClimbingDeferredClimbers, STATGROUP_Climbing, );
+
+CSV_DECLARE_CATEGORY_EXTERN(Climbing);
+
+/** Insights channel of the climbing system, enabled with -trace=cpu,climbing */
+UE_TRACE_CHANNEL_EXTERN(ClimbingChannel);
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Game thread time and scene queries spent in climbing code since the last Reset(). Gathered outside of
+ * the stats system, so the benchmark commandlet can read them in any build but Shipping.
+ */
+struct FClimbingFrameCounters
+{
+	uint64 Cycles = 0;
+	uint32 SceneQueries = 0;
+
+	/** Probes answered from the height data of a landscape instead of a query */
+	uint32 LandscapeSamples = 0;
+
+	static FClimbingFrameCounters& Get();
+
+	void Reset()
+	{
+		Cycles = 0;
+		SceneQueries = 0;
+		LandscapeSamples = 0;
+	}
+};
+
+/** Adds the time of the outermost climbing scope to FClimbingFrameCounters */
+class FClimbingScopeTimer
+{
+public:
+	FClimbingScopeTimer();
+	~FClimbingScopeTimer();
+
+private:
+	uint64 StartCycles;
+	bool bOutermost;
+};
+
+#define CLIMBING_SCOPE_TIMER() FClimbingScopeTimer ANONYMOUS_VARIABLE(ClimbingScopeTimer_)
+#define CLIMBING_COUNT_QUERIES(Count) FClimbingFrameCounters::Get().SceneQueries += (Count)
+#define CLIMBING_COUNT_LANDSCAPE_SAMPLES(Count) FClimbingFrameCounters::Get().LandscapeSamples += (Count)
+#else
+#define CLIMBING_SCOPE_TIMER()
+#define CLIMBING_COUNT_QUERIES(Count)
+#define CLIMBING_COUNT_LANDSCAPE_SAMPLES(Count)
+#endif
+
+/** Times a scope in the climbing stats group, in the Insights climbing channel and in the CSV profiler */
+#define CLIMBING_SCOPE_CYCLE_COUNTER(Stat) \
+	CLIMBING_SCOPE_TIMER(); \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, ClimbingChannel); \
+	CSV_SCOPED_TIMING_STAT(Climbing, Stat)
+
+/** Counts the sweeps issued by the climbing system, in the stats group and in the CSV profiler */
+#define CLIMBING_COUNT_SWEEPS(Count) \
+	CLIMBING_COUNT_QUERIES(Count); \
+	INC_DWORD_STAT_BY(STAT_ClimbingSweeps, Count); \
+	CSV_CUSTOM_STAT(Climbing, Sweeps, static_cast<int32>(Count), ECsvCustomStatOp::Accumulate)
@@ -0,0 +1,366 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingSubsystem.h"
+
+#include "ClimbableSurfaceIndex.h"
+#include "ClimbingMovementComponent.h"
+#include "ClimbingStats.h"
+#include "ClimbingSystem.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "SignificanceManager.h"
+
+static int32 GClimbingMinParallelClimbers = 8;
+static FAutoConsoleVariableRef CVarClimbingMinParallelClimbers(
+	TEXT("climbing.MinParallelClimbers"),
+	GClimbingMinParallelClimbers,
+	TEXT("Number of climbers below which the batch solve runs on the game thread only"));
+
+static int32 GClimbingProbeBudget = 128;
+static FAutoConsoleVariableRef CVarClimbingProbeBudget(
+	TEXT("climbing.ProbeBudget"),
+	GClimbingProbeBudget,
+	TEXT("Max sweeps submitted by all the climbers of a world in a frame, 0 for no limit"));
+
+static float GClimbingSignificanceDistance = 1500.f;
+static FAutoConsoleVariableRef CVarClimbingSignificanceDistance(
+	TEXT("climbing.SignificanceDistance"),
+	GClimbingSignificanceDistance,
+	TEXT("Distance from the closest player view at which the significance of a climber is halved"));
+
+static float GClimbingFullSignificance = 0.5f;
+static FAutoConsoleVariableRef CVarClimbingFullSignificance(
+	TEXT("climbing.FullSignificance"),
+	GClimbingFullSignificance,
+	TEXT("Significance at and above which a climber probes every frame with the full plane fit grid"));
+
+static int32 GClimbingMaxProbeInterval = 8;
+static FAutoConsoleVariableRef CVarClimbingMaxProbeInterval(
+	TEXT("climbing.MaxProbeInterval"),
+	GClimbingMaxProbeInterval,
+	TEXT("Frames between two probes of the least significant climbers"));
+
+namespace ClimbingSignificance
+{
+	static const FName Tag(TEXT("Climber"));
+
+	/** Player climbers are always fully significant, the others fade with the distance from the view */
+	static float Calculate(USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+	{
+		const UClimbingMovementComponent* Climber = Cast<UClimbingMovementComponent>(ObjectInfo->GetObject());
+		if (!Climber || !Climber->UpdatedComponent)
+		{
+			return 0.f;
+		}
+
+		const APawn* Pawn = Climber->GetPawnOwner();
+		if (Pawn && Pawn->IsPlayerControlled())
+		{
+			return 1.f;
+		}
+
+		const float Distance = FVector::Dist(Viewpoint.GetLocation(), Climber->UpdatedComponent->GetComponentLocation());
+		return 1.f / (1.f + Distance / FMath::Max(GClimbingSignificanceDistance, 1.f));
+	}
+
+	/** Frames between two probes of a climber, from every frame at full significance to climbing.MaxProbeInterval at none */
+	static int32 GetProbeInterval(float Significance)
+	{
+		if (Significance >= GClimbingFullSignificance)
+		{
+			return 1;
+		}
+
+		const int32 MaxInterval = FMath::Max(GClimbingMaxProbeInterval, 2);
+		const float Alpha = 1.f - Significance / FMath::Max(GClimbingFullSignificance, KINDA_SMALL_NUMBER);
+		return FMath::Clamp(FMath::RoundToInt(FMath::Lerp(2.f, static_cast<float>(MaxInterval), Alpha)), 2, MaxInterval);
+	}
+}
+
+void FClimbingBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem)
+	{
+		if (bSubmitProbes)
+		{
+			Subsystem->SubmitClimberProbes();
+		}
+		else
+		{
+			Subsystem->SolveClimbers();
+		}
+	}
+}
+
+FString FClimbingBatchTickFunction::DiagnosticMessage()
+{
+	return bSubmitProbes ? TEXT("UClimbingSubsystem[SubmitProbes]") : TEXT("UClimbingSubsystem[Solve]");
+}
+
+void UClimbingSubsystem::FClimberArrays::SetNumWorkingSet(int32 Num)
+{
+	Inputs.SetNumUninitialized(Num, false);
+	SolverSettings.SetNumUninitialized(Num, false);
+	SolveInputs.SetNum(Num, false);
+	SolveOutputs.SetNum(Num, false);
+	Significances.SetNumUninitialized(Num, false);
+	PlayerControlled.SetNumUninitialized(Num, false);
+}
+
+void UClimbingSubsystem::FClimberArrays::RemoveAtSwap(int32 Index)
+{
+	// The working set is rebuilt every frame, only the climbers persist
+	Components.RemoveAtSwap(Index, 1, false);
+	FramesSinceProbes.RemoveAtSwap(Index, 1, false);
+}
+
+void UClimbingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SolveTickFunction.Subsystem = this;
+	SolveTickFunction.bSubmitProbes = false;
+	SolveTickFunction.TickGroup = TG_PrePhysics;
+	SolveTickFunction.bCanEverTick = true;
+	SolveTickFunction.bStartWithTickEnabled = true;
+
+	SubmitTickFunction.Subsystem = this;
+	SubmitTickFunction.bSubmitProbes = true;
+	SubmitTickFunction.TickGroup = TG_PostPhysics;
+	SubmitTickFunction.bCanEverTick = true;
+	SubmitTickFunction.bStartWithTickEnabled = true;
+
+	const UWorld* World = GetWorld();
+	if (World && World->IsGameWorld())
+	{
+		LoadSurfaceIndex();
+	}
+}
+
+void UClimbingSubsystem::Deinitialize()
+{
+	SolveTickFunction.UnRegisterTickFunction();
+	SubmitTickFunction.UnRegisterTickFunction();
+	Climbers = FClimberArrays();
+	SurfaceIndex = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UClimbingSubsystem::RegisterClimber(UClimbingMovementComponent* Climber)
+{
+	check(Climber);
+
+	// The batch only ticks once there is something to climb
+	if (!SolveTickFunction.IsTickFunctionRegistered())
+	{
+		ULevel* Level = GetWorld()->PersistentLevel;
+		SolveTickFunction.RegisterTickFunction(Level);
+		SubmitTickFunction.RegisterTickFunction(Level);
+	}
+
+	if (!Climbers.Components.Contains(Climber))
+	{
+		Climbers.Components.Add(Climber);
+		Climbers.FramesSinceProbes.Add(0);
+		Climber->PrimaryComponentTick.AddPrerequisite(this, SolveTickFunction);
+
+		if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+		{
+			SignificanceManager->RegisterObject(Climber, ClimbingSignificance::Tag, ClimbingSignificance::Calculate);
+		}
+	}
+}
+
+void UClimbingSubsystem::UnregisterClimber(UClimbingMovementComponent* Climber)
+{
+	const int32 Index = Climbers.Components.IndexOfByKey(Climber);
+	if (Index != INDEX_NONE)
+	{
+		Climbers.RemoveAtSwap(Index);
+		Climber->PrimaryComponentTick.RemovePrerequisite(this, SolveTickFunction);
+
+		if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+		{
+			SignificanceManager->UnregisterObject(Climber);
+		}
+	}
+}
+
+void UClimbingSubsystem::SolveClimbers()
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingBatchSolve);
+
+	// Climbers destroyed while climbing never unregistered
+	for (int32 Index = Climbers.Components.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Climbers.Components[Index].IsValid())
+		{
+			Climbers.RemoveAtSwap(Index);
+		}
+	}
+
+	const int32 NumClimbers = Climbers.Components.Num();
+	if (NumClimbers == 0)
+	{
+		return;
+	}
+	Climbers.SetNumWorkingSet(NumClimbers);
+	UpdateSignificance();
+
+	// Gather: async results can only be read on the game thread. Climbers with fixed steps that won't step this frame are not solved
+	const float DeltaSeconds = GetWorld()->GetDeltaSeconds();
+	for (int32 Index = 0; Index < NumClimbers; ++Index)
+	{
+		UClimbingMovementComponent* Climber = Climbers.Components[Index].Get();
+		Climber->ConsumeClimbProbes();
+		Climbers.Inputs[Index] = Climber->IsClimbingStepDue(DeltaSeconds) ? Climber->GetClimbInput() : FVector2D::ZeroVector;
+		Climbers.SolverSettings[Index] = Climber->GetSolverSettings();
+	}
+
+	// Resolve: each climber only touches its own probes, surface cache and wall
+	ParallelFor(NumClimbers, [this](int32 Index)
+	{
+		const FVector2D& ClimbInput = Climbers.Inputs[Index];
+		if (ClimbInput.IsNearlyZero())
+		{
+			Climbers.SolveInputs[Index] = FClimbingSolveInput();
+			return;
+		}
+
+		Climbers.Components[Index]->ResolveClimbProbes(ClimbInput, Climbers.SolveInputs[Index]);
+	}, NumClimbers < GClimbingMinParallelClimbers);
+
+	// Solve: plain data from here, the climbers without input come out with no wall and are not written back
+	FClimbingSolver::SolveBatch(Climbers.SolverSettings, Climbers.SolveInputs, Climbers.SolveOutputs);
+
+	// Write back: the movement components apply the poses when they tick
+	for (int32 Index = 0; Index < NumClimbers; ++Index)
+	{
+		if (!Climbers.Inputs[Index].IsNearlyZero())
+		{
+			Climbers.Components[Index]->SetBatchSolve(Climbers.Inputs[Index], Climbers.SolveInputs[Index].Location, Climbers.SolveOutputs[Index]);
+		}
+	}
+}
+
+void UClimbingSubsystem::SubmitClimberProbes()
+{
+	CLIMBING_SCOPE_CYCLE_COUNTER(STAT_ClimbingBatchSubmit);
+
+	const USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	const int32 NumClimbers = Climbers.Components.Num();
+	Climbers.Significances.SetNumUninitialized(NumClimbers, false);
+	Climbers.PlayerControlled.SetNumUninitialized(NumClimbers, false);
+
+	// Climbers that are due for probes, the less significant ones probe less often. Climbers with fixed steps
+	// only probe for the frames they step in, guessed from the length of this one
+	const float DeltaSeconds = GetWorld()->GetDeltaSeconds();
+	SubmitOrder.Reset();
+	for (int32 Index = 0; Index < NumClimbers; ++Index)
+	{
+		const UClimbingMovementComponent* Climber = Climbers.Components[Index].Get();
+		if (!Climber || !Climber->IsClimbing() || !Climber->IsClimbingStepDue(DeltaSeconds))
+		{
+			continue;
+		}
+
+		const float Significance = SignificanceManager ? SignificanceManager->GetSignificance(Climber) : 1.f;
+		Climbers.Significances[Index] = Significance;
+		const APawn* Pawn = Climber->GetPawnOwner();
+		Climbers.PlayerControlled[Index] = Pawn && Pawn->IsPlayerControlled();
+		if (++Climbers.FramesSinceProbes[Index] >= ClimbingSignificance::GetProbeInterval(Significance))
+		{
+			SubmitOrder.Add(Index);
+		}
+	}
+
+	// Players first, however long the others waited. Then every frame a climber waits raises its priority,
+	// so the budget can't starve it
+	SubmitOrder.Sort([this](int32 A, int32 B)
+	{
+		if (Climbers.PlayerControlled[A] != Climbers.PlayerControlled[B])
+		{
+			return Climbers.PlayerControlled[A];
+		}
+		return Climbers.Significances[A] * Climbers.FramesSinceProbes[A] > Climbers.Significances[B] * Climbers.FramesSinceProbes[B];
+	});
+
+	const int32 Budget = GClimbingProbeBudget > 0 ? GClimbingProbeBudget : MAX_int32;
+	int32 NumSweeps = 0;
+	int32 NumDeferred = 0;
+	for (const int32 Index : SubmitOrder)
+	{
+		UClimbingMovementComponent* Climber = Climbers.Components[Index].Get();
+		const bool bWithPattern = Climbers.Significances[Index] >= GClimbingFullSignificance;
+		int32 NumQueued = Climber->QueueClimbProbes(bWithPattern);
+
+		// Over budget the plane fit grid goes first
+		if (bWithPattern && NumQueued > Budget - NumSweeps)
+		{
+			Climber->DropQueuedProbes();
+			NumQueued = Climber->QueueClimbProbes(false);
+		}
+
+		// Still over budget the climber moves along its last solved surface, and tries again next frame. The first
+		// climber of the frame always goes, a budget smaller than the probes of one climber would defer it for good
+		if (NumSweeps > 0 && NumQueued > Budget - NumSweeps)
+		{
+			Climber->DropQueuedProbes();
+			++NumDeferred;
+			continue;
+		}
+
+		NumSweeps += Climber->SubmitQueuedProbes();
+		Climbers.FramesSinceProbes[Index] = 0;
+	}
+
+	INC_DWORD_STAT_BY(STAT_ClimbingDeferredClimbers, NumDeferred);
+}
+
+void UClimbingSubsystem::UpdateSignificance()
+{
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (!SignificanceManager)
+	{
+		return;
+	}
+
+	// On a server every player has a controller, so the climbers are ranked against all the players
+	TArray<FTransform, TInlineAllocator<4>> Viewpoints;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			FVector Location;
+			FRotator Rotation;
+			PlayerController->GetPlayerViewPoint(Location, Rotation);
+			Viewpoints.Emplace(Rotation, Location);
+		}
+	}
+
+	SignificanceManager->Update(Viewpoints);
+}
+
+void UClimbingSubsystem::LoadSurfaceIndex()
+{
+	// The index is saved next to the map, PIE worlds have a prefix the original package doesn't
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName());
+	const FString IndexPackageName = MapName + UClimbableSurfaceIndex::AssetSuffix;
+	if (!FPackageName::DoesPackageExist(IndexPackageName))
+	{
+		UE_LOG(LogClimbing, Verbose, TEXT("No climbable surface index for %s, every probe will be traced"), *MapName);
+		return;
+	}
+
+	const FString ObjectPath = IndexPackageName + TEXT(".") + FPackageName::GetShortName(IndexPackageName);
+	SurfaceIndex = LoadObject<UClimbableSurfaceIndex>(nullptr, *ObjectPath);
+	if (SurfaceIndex)
+	{
+		UE_LOG(LogClimbing, Log, TEXT("Loaded climbable surface index %s with %d patches"), *ObjectPath, SurfaceIndex->Patches.Num());
+	}
+}
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingSolver.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbingSubsystem.generated.h"
+
+class UClimbableSurfaceIndex;
+class UClimbingMovementComponent;
+class UClimbingSubsystem;
+
+/** Runs a phase of the climbers batch of UClimbingSubsystem */
+USTRUCT()
+struct FClimbingBatchTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UClimbingSubsystem* Subsystem = nullptr;
+
+	/** Solves before the movement components tick if false, submits the probes after they moved if true */
+	bool bSubmitProbes = false;
+
+	//Begin FTickFunction Interface
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	//End FTickFunction Interface
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbingBatchTickFunction> : public TStructOpsTypeTraitsBase2<FClimbingBatchTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Climbing data shared by every climber of a world. The climbers are updated together: the probe
+ * results of all of them are gathered in one pass, the surface solve runs for all of them in parallel
+ * and the solved poses are written back to the movement components before they tick. After they
+ * moved, the probes of all the climbers are submitted in one pass.
+ */
+UCLASS()
+class UClimbingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//End USubsystem Interface
+
+	/** Baked surfaces of the current map, null if the map was never baked */
+	const UClimbableSurfaceIndex* GetSurfaceIndex() const { return SurfaceIndex; }
+
+	/** Adds a climber to the batch, its movement component will tick after the batch solve */
+	void RegisterClimber(UClimbingMovementComponent* Climber);
+
+	void UnregisterClimber(UClimbingMovementComponent* Climber);
+
+	int32 GetNumClimbers() const { return Climbers.Components.Num(); }
+
+private:
+	friend struct FClimbingBatchTickFunction;
+
+	/** Consumes the probes of every climber, solves them in parallel and writes the poses back */
+	void SolveClimbers();
+
+	/** Submits the probes of the climbers for the pose they just reached, by priority and within climbing.ProbeBudget */
+	void SubmitClimberProbes();
+
+	/** Updates the significance manager of the world from the view of every player */
+	void UpdateSignificance();
+
+	/** Loads the index baked next to the map of the world, if any */
+	void LoadSurfaceIndex();
+
+	/**
+	 * Climbers in structure of arrays form, the same index in every array is the same climber.
+	 * Components and FramesSinceProbes persist between frames, the other arrays are the working set of the batch.
+	 */
+	struct FClimberArrays
+	{
+		TArray<TWeakObjectPtr<UClimbingMovementComponent>> Components;
+
+		/** Frames since the climber last submitted its probes */
+		TArray<int32> FramesSinceProbes;
+
+		/** Gathered on the game thread */
+		TArray<FVector2D> Inputs;
+		TArray<FClimbingSolverSettings> SolverSettings;
+
+		/** Probe hits, resolved in parallel */
+		TArray<FClimbingSolveInput> SolveInputs;
+
+		/** Solve outputs, written back on the game thread */
+		TArray<FClimbingSolveOutput> SolveOutputs;
+
+		/** Significance of the climbers, read when the probes are submitted */
+		TArray<float> Significances;
+
+		/** Is the climber controlled by a player? Players submit their probes before any other climber */
+		TArray<bool> PlayerControlled;
+
+		void SetNumWorkingSet(int32 Num);
+		void RemoveAtSwap(int32 Index);
+	};
+
+	FClimberArrays Climbers;
+
+	/** Climbers due for probes this frame, most important first */
+	TArray<int32> SubmitOrder;
+
+	FClimbingBatchTickFunction SolveTickFunction;
+	FClimbingBatchTickFunction SubmitTickFunction;
+
+	UPROPERTY()
+	UClimbableSurfaceIndex* SurfaceIndex = nullptr;
+};
@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingSurfaceCache.h"
+
+#include "Components/SkinnedMeshComponent.h"
+
+FClimbingSurfaceCache::FClimbingSurfaceCache()
+	: HitCount(0)
+	, MissCount(0)
+{
+}
+
+void FClimbingSurfaceCache::Store(EClimbingProbe Probe, const FHitResult& Hit)
+{
+	UPrimitiveComponent* Component = Hit.GetComponent();
+	if (!Component)
+	{
+		Invalidate(Probe);
+		return;
+	}
+
+	FEntry& Entry = Entries[static_cast<int32>(Probe)];
+	Entry.Component = Component;
+	Entry.Mobility = Component->Mobility;
+	Entry.ComponentTransform = Component->GetComponentTransform();
+	Entry.bRigid = !Component->IsA<USkinnedMeshComponent>();
+	Entry.LocalLocation = Entry.ComponentTransform.InverseTransformPosition(Hit.Location);
+	Entry.LocalNormal = Entry.ComponentTransform.InverseTransformVectorNoScale(Hit.Normal.GetSafeNormal());
+	Entry.PhysMaterial = Hit.PhysMaterial;
+	Entry.LocalTraceStart = Entry.ComponentTransform.InverseTransformPosition(Hit.TraceStart);
+	Entry.LocalTraceDirection = Entry.ComponentTransform.InverseTransformVectorNoScale((Hit.TraceEnd - Hit.TraceStart).GetSafeNormal());
+}
+
+void FClimbingSurfaceCache::Invalidate(EClimbingProbe Probe)
+{
+	Entries[static_cast<int32>(Probe)] = FEntry();
+}
+
+void FClimbingSurfaceCache::Reset()
+{
+	for (FEntry& Entry : Entries)
+	{
+		Entry = FEntry();
+	}
+}
+
+bool FClimbingSurfaceCache::CanServe(EClimbingProbe Probe, const FVector& Start, const FVector& End, float DistanceTolerance, float AngleTolerance) const
+{
+	FVector Location, Normal;
+	float Time;
+	return Intersect(Entries[static_cast<int32>(Probe)], Start, End, DistanceTolerance, AngleTolerance, Location, Normal, Time);
+}
+
+bool FClimbingSurfaceCache::Query(EClimbingProbe Probe, const FVector& Start, const FVector& End, float DistanceTolerance, float AngleTolerance, FHitResult& OutHit)
+{
+	const FEntry& Entry = Entries[static_cast<int32>(Probe)];
+
+	FVector Location, Normal;
+	float Time;
+	if (!Intersect(Entry, Start, End, DistanceTolerance, AngleTolerance, Location, Normal, Time))
+	{
+		++MissCount;
+		return false;
+	}
+
+	UPrimitiveComponent* Component = Entry.Component.Get();
+	OutHit = FHitResult(Start, End);
+	OutHit.bBlockingHit = true;
+	OutHit.Time = Time;
+	OutHit.Location = Location;
+	OutHit.ImpactPoint = Location;
+	OutHit.Normal = Normal;
+	OutHit.ImpactNormal = Normal;
+	OutHit.Component = Component;
+	OutHit.Actor = Component->GetOwner();
+	OutHit.PhysMaterial = Entry.PhysMaterial;
+	OutHit.Distance = (Location - Start).Size();
+	++HitCount;
+	return true;
+}
+
+void FClimbingSurfaceCache::ResetCounters()
+{
+	HitCount = 0;
+	MissCount = 0;
+}
+
+bool FClimbingSurfaceCache::Intersect(const FEntry& Entry, const FVector& Start, const FVector& End, float DistanceTolerance, float AngleTolerance,
+                                      FVector& OutLocation, FVector& OutNormal, float& OutTime) const
+{
+	const UPrimitiveComponent* Component = Entry.Component.Get();
+	if (!Component)
+	{
+		return false;
+	}
+
+	// A movable component that moved carries the surface along, unless its shape or scale may have changed
+	const FTransform& ComponentTransform = Component->GetComponentTransform();
+	if (Entry.Mobility == EComponentMobility::Movable && !Entry.ComponentTransform.Equals(ComponentTransform) &&
+	    (!Entry.bRigid || !Entry.ComponentTransform.GetScale3D().Equals(ComponentTransform.GetScale3D())))
+	{
+		return false;
+	}
+
+	// The character moved or turned too much on the component since the surface was traced
+	if (FVector::DistSquared(Start, ComponentTransform.TransformPosition(Entry.LocalTraceStart)) > FMath::Square(DistanceTolerance))
+	{
+		return false;
+	}
+
+	const FVector TraceDirection = End - Start;
+	if (FVector::DotProduct(TraceDirection.GetSafeNormal(), ComponentTransform.TransformVectorNoScale(Entry.LocalTraceDirection)) <
+	    FMath::Cos(FMath::DegreesToRadians(AngleTolerance)))
+	{
+		return false;
+	}
+
+	const FVector PlaneLocation = ComponentTransform.TransformPosition(Entry.LocalLocation);
+	const FVector PlaneNormal = ComponentTransform.TransformVectorNoScale(Entry.LocalNormal);
+
+	const float Denominator = FVector::DotProduct(TraceDirection, PlaneNormal);
+	if (FMath::IsNearlyZero(Denominator))
+	{
+		return false;
+	}
+
+	OutTime = FVector::DotProduct(PlaneLocation - Start, PlaneNormal) / Denominator;
+	if (OutTime < 0.f || OutTime > 1.f)
+	{
+		return false;
+	}
+
+	// Past the edge of the component the wall may be over, that has to be traced
+	OutLocation = Start + OutTime * TraceDirection;
+	if (!Component->Bounds.GetBox().ExpandBy(1.f).IsInside(OutLocation))
+	{
+		return false;
+	}
+
+	OutNormal = PlaneNormal;
+	return true;
+}
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingProbeBatch.h"
+#include "Components/PrimitiveComponent.h"
+
+/**
+ * Remembers the surface each probe of a climber hit last, in the local space of the hit component.
+ * As long as the probe did not move or turn past the tolerances relative to the component, the probe is
+ * served from the cached plane instead of being traced again. A rigid component that moves carries the
+ * surface with it, one that deforms or is scaled invalidates it.
+ */
+class FClimbingSurfaceCache
+{
+public:
+	FClimbingSurfaceCache();
+
+	/** Stores the surface hit by a probe that was actually traced */
+	void Store(EClimbingProbe Probe, const FHitResult& Hit);
+
+	/** Forgets the surface of a probe, used when the probe missed */
+	void Invalidate(EClimbingProbe Probe);
+
+	/** Forgets every surface */
+	void Reset();
+
+	/** Checks if a probe can be served by the cache, without touching the counters
+	 *  @param DistanceTolerance How far the probe can start from where it was traced
+	 *  @param AngleTolerance How much the probe direction can turn, in degrees
+	 */
+	bool CanServe(EClimbingProbe Probe, const FVector& Start, const FVector& End, float DistanceTolerance, float AngleTolerance) const;
+
+	/** Serves a probe from the cache, counting a hit or a miss
+	 *  @return True if OutHit holds the probe hit on the cached surface
+	 */
+	bool Query(EClimbingProbe Probe, const FVector& Start, const FVector& End, float DistanceTolerance, float AngleTolerance, FHitResult& OutHit);
+
+	/** Number of probes served by the cache */
+	uint32 GetHitCount() const { return HitCount; }
+
+	/** Number of probes that had to use a trace result */
+	uint32 GetMissCount() const { return MissCount; }
+
+	void ResetCounters();
+
+private:
+	static constexpr int32 NumProbes = static_cast<int32>(EClimbingProbe::Num);
+
+	struct FEntry
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+
+		/** Hit point and normal in the component space */
+		FVector LocalLocation = FVector::ZeroVector;
+		FVector LocalNormal = FVector::ZeroVector;
+
+		/** Material of the hit, so served probes keep the climbing rules of the surface */
+		TWeakObjectPtr<UPhysicalMaterial> PhysMaterial;
+
+		/** Mobility and transform of the component when it was hit */
+		EComponentMobility::Type Mobility = EComponentMobility::Static;
+		FTransform ComponentTransform;
+
+		/** False for components whose surface changes shape, like skinned meshes, they have to stay put */
+		bool bRigid = true;
+
+		/** Start and direction of the probe that found the surface, in the component space */
+		FVector LocalTraceStart = FVector::ZeroVector;
+		FVector LocalTraceDirection = FVector::ZeroVector;
+	};
+
+	/** Finds where the probe crosses the cached surface, false if the entry can't serve it */
+	bool Intersect(const FEntry& Entry, const FVector& Start, const FVector& End, float DistanceTolerance, float AngleTolerance,
+	               FVector& OutLocation, FVector& OutNormal, float& OutTime) const;
+
+	FEntry Entries[NumProbes];
+
+	uint32 HitCount;
+	uint32 MissCount;
+};
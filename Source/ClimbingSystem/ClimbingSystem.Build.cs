@@ -8,6 +8,14 @@ public class ClimbingSystem : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "SignificanceManager", "AIModule", "GameplayTasks", "NavigationSystem" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "Landscape", "PhysicsCore" });
+
+		// Blueprint compile and save of the Anim Blueprint fixup commandlet
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 	}
 }
@@ -3,3 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogClimbing, Log, All);
+
+/** Trace channel of the climbing queries, named Climbable in DefaultEngine.ini. Geometry that ignores it can't be climbed */
+#define ECC_Climbable ECC_GameTraceChannel1
@@ -2,21 +2,20 @@
 
 #include "ClimbingSystemCharacter.h"
 
-#include "DrawDebugHelpers.h"
+#include "ClimbingAIController.h"
+#include "ClimbingMovementComponent.h"
 #include "HeadMountedDisplayFunctionLibrary.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/InputComponent.h"
-#include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
 
 //////////////////////////////////////////////////////////////////////////
 // AClimbingSystemCharacter
 
-AClimbingSystemCharacter::AClimbingSystemCharacter()
+AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UClimbingMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
@@ -36,6 +35,14 @@ AClimbingSystemCharacter::AClimbingSystemCharacter()
 	GetCharacterMovement()->JumpZVelocity = 600.f;
 	GetCharacterMovement()->AirControl = 0.2f;
 
+	// AI pawns climb along the climb nav links
+	AIControllerClass = AClimbingAIController::StaticClass();
+
+	// Defaults of the angles when they were on the character, only the values that differ were saved
+	MinClimbAngle_DEPRECATED = -75.f;
+	MaxClimbAngle_DEPRECATED = 45.f;
+	MaxTurnAngle_DEPRECATED = 65.f;
+
 	// Create a camera boom (pulls in towards the player if there is a collision)
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
 	CameraBoom->SetupAttachment(RootComponent);
@@ -48,23 +55,39 @@ AClimbingSystemCharacter::AClimbingSystemCharacter()
 	// Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
-	// Set the allowed angles for climbing
-	MinClimbAngle = -75.f;
-	MaxClimbAngle = 45.f;
-	MaxTurnAngle = 65.f;
-	bClimbing = false;
-
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named MyCharacter (to avoid direct content references in C++)
 }
 
-void AClimbingSystemCharacter::BeginPlay()
+UClimbingMovementComponent* AClimbingSystemCharacter::GetClimbingMovement() const
 {
-	Super::BeginPlay();
-	// Delegates initialization
-	// IMPORTANT: HAS TO BE DONE HERE, INSIDE THE CONSTRUCTOR CAUSES ERRORS!
-	LandedDelegate.AddDynamic(this, &AClimbingSystemCharacter::CharacterOnLand);
-	OnReachedJumpApex.AddDynamic(this, &AClimbingSystemCharacter::CharacterReachedJumpApex);
+	return CastChecked<UClimbingMovementComponent>(GetCharacterMovement());
+}
+
+void AClimbingSystemCharacter::PostLoad()
+{
+	Super::PostLoad();
+
+	// Angles saved on the character before they moved to the movement component are moved to it
+	const AClimbingSystemCharacter* Defaults = GetDefault<AClimbingSystemCharacter>();
+	UClimbingMovementComponent* Movement = Cast<UClimbingMovementComponent>(GetCharacterMovement());
+	if (this == Defaults || !Movement)
+	{
+		return;
+	}
+
+	if (MinClimbAngle_DEPRECATED != Defaults->MinClimbAngle_DEPRECATED)
+	{
+		Movement->MinClimbAngle = MinClimbAngle_DEPRECATED;
+	}
+	if (MaxClimbAngle_DEPRECATED != Defaults->MaxClimbAngle_DEPRECATED)
+	{
+		Movement->MaxClimbAngle = MaxClimbAngle_DEPRECATED;
+	}
+	if (MaxTurnAngle_DEPRECATED != Defaults->MaxTurnAngle_DEPRECATED)
+	{
+		Movement->MaxTurnAngle = MaxTurnAngle_DEPRECATED;
+	}
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -99,50 +122,6 @@ void AClimbingSystemCharacter::SetupPlayerInputComponent(class UInputComponent*
 	PlayerInputComponent->BindAction("GrabWall", IE_Pressed, this, &AClimbingSystemCharacter::HandleWallGrab);
 }
 
-void AClimbingSystemCharacter::AttachToWall()
-{
-	// Check if there is a wall in front of the character
-	FHitResult WallTraceHitResult;
-	const FVector Start = GetCapsuleComponent()->GetComponentLocation();
-	const FVector End = Start + (GetCapsuleComponent()->GetScaledCapsuleRadius()*3.f*GetActorForwardVector());
-	if (!WallTrace(WallTraceHitResult, Start, End, FColor::Green))
-	{
-		// If there is not a wall in front of the character, make sure to detach
-		DetachFromWall();
-		return;
-	}
-
-	// There is a wall in front of the character, set movement mode to Flying,
-	// stop movement and stop orienting the rotation to the movement
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
-	GetCharacterMovement()->StopMovementImmediately();
-	GetCharacterMovement()->bOrientRotationToMovement = false;
-
-	const FVector TargetPosition =
-		GetCapsuleComponent()->GetScaledCapsuleRadius() * WallTraceHitResult.Normal + WallTraceHitResult.Location;
-	const FRotator TargetRotation =
-		UKismetMathLibrary::MakeRotFromX(-WallTraceHitResult.Normal);
-
-	FLatentActionInfo LatentInfo;
-	LatentInfo.CallbackTarget = this;
-
-	// Move the character to the wall
-	UKismetSystemLibrary::MoveComponentTo(GetCapsuleComponent(), TargetPosition, TargetRotation,
-	                                      false, false, 0.2f, false, EMoveComponentAction::Move, LatentInfo);
-}
-
-void AClimbingSystemCharacter::DetachFromWall()
-{
-	bClimbing = false;
-	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Flying)
-	{
-		GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
-	}
-
-	GetCharacterMovement()->bOrientRotationToMovement = true;
-	ResetRotation();
-}
-
 void AClimbingSystemCharacter::HandleWallGrab()
 {
 	const EMovementMode MovementMode = GetCharacterMovement()->MovementMode;
@@ -150,167 +129,24 @@ void AClimbingSystemCharacter::HandleWallGrab()
 	// If the character is not attached to a wall, try to find one, else detach from it
 	if (MovementMode == EMovementMode::MOVE_Walking || MovementMode == EMovementMode::MOVE_Falling)
 	{
-		AttachToWall();
-	}
-	else if (MovementMode == EMovementMode::MOVE_Flying)
-	{
-		DetachFromWall();
+		GetClimbingMovement()->SetWantsToClimb(true);
 	}
-}
-
-bool AClimbingSystemCharacter::WallTrace(FHitResult& OutHit, FVector Start, FVector End, FColor Color)
-{
-	DrawDebugLine(GetWorld(), Start, End, Color, false, 0.3f, 0, 2.f);
-	return GetWorld()->SweepSingleByChannel(
-		OutHit, Start, End,
-		FQuat::Identity, ECollisionChannel::ECC_Visibility,
-		FCollisionShape::MakeBox(FVector(0.01f, 0.01f, 0.01f)));
-}
-
-void AClimbingSystemCharacter::ResetRotation()
-{
-	// Need to add a gradual interpolation, with a timer or something like that
-	const FRotator Rotation = GetActorRotation();
-	SetActorRotation(FRotator{0.f, Rotation.Yaw, Rotation.Roll}, ETeleportType::None);
-}
-
-void AClimbingSystemCharacter::WallClimbMovement(float Axis, FVector Direction,bool bVertical)
-{
-	// If there is no input, there is no movement
-	if (Axis == 0) return;
-
-	float Offset = (bVertical ? GetCapsuleComponent()->GetScaledCapsuleHalfHeight()*1.f : GetCapsuleComponent()->GetScaledCapsuleRadius()*1.5f);
-	float RayLength = 80.f;
-	
-	// Do a boxcast in the direction of the character movement
-	FVector Start1 = Offset * Direction * Axis + GetActorLocation();
-	FVector End1 = Start1 + (GetCapsuleComponent()->GetScaledCapsuleRadius() * 2  * GetActorForwardVector());
-
-	FVector Start2 = GetActorLocation();
-	FVector End2 = Start2 + RayLength * GetActorForwardVector();
-
-	bool bHit1, bHit2;
-	FHitResult OutHit1, OutHit2;
-	
-	bHit1 = WallTrace(OutHit1, Start1, End1, FColor::Purple);
-	
-	bHit2 = WallTrace(OutHit2, Start2, End2, FColor::Red);
-	
-	if ( bHit1)
-	{
-		FVector N1 = OutHit1.Normal;
-		FVector N2 = OutHit2.Normal;
-		N1.Normalize();
-		N2.Normalize();
-		
-		// The angle between the wall in front of the character, and the wall in the direction the
-		// character is moving: if this is higher than MaxTurnAngle, movement is stopped
-		float Angle1F = UKismetMathLibrary::Abs(
-			UKismetMathLibrary::DegAcos(
-				UKismetMathLibrary::Dot_VectorVector(
-					N1, N2)));
-
-		//UE_LOG(LogTemp, Warning, TEXT("Walls Angle1R: %f, 1 Angle1F: %f"), Angle1R, Angle1F);
-
-		// Check for lateral movement maximum angle
-		if(Angle1F > MaxTurnAngle)
-			return;
-
-		float ClimbAngle = UKismetMathLibrary::MakeRotFromX(-OutHit1.Normal).Pitch;
-
-		if(ClimbAngle > MaxClimbAngle || ClimbAngle < MinClimbAngle)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Climb Angle Invalid: %f"), ClimbAngle);
-			return;
-		}
-
-		FVector Target = OutHit1.Location - GetActorLocation();
-
-		// Finally movement and rotation can be applied
-		FVector WorldDirection =
-			UKismetMathLibrary::GetDirectionUnitVector(
-				GetActorLocation(),
-				OutHit1.Normal * GetCapsuleComponent()->GetScaledCapsuleRadius() + OutHit1.Location)
-			* UKismetMathLibrary::SignOfFloat(Axis);
-
-		// Final movement added to character
-		AddMovementInput(WorldDirection, Axis);
-
-		// Also character rotation is adjusted
-		FRotator TargetWallRotation;
-		TargetWallRotation = UKismetMathLibrary::MakeRotFromX(-OutHit1.Normal);
-		const FRotator NewRotation = UKismetMathLibrary::RInterpTo(
-			GetActorRotation(), TargetWallRotation, GetWorld()->GetDeltaSeconds(),
-			5.f);
-		SetActorRotation(NewRotation, ETeleportType::None);
-		bClimbing = true;
-	}
-	else
+	else if (GetClimbingMovement()->IsClimbing() || GetClimbingMovement()->IsHanging())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Wall not found!"));
-		// Vault?
-		// Check if the character can vault up
-		// Is the input upwards relative to character?
-		if(Direction == GetActorUpVector() && Axis > 0 && bClimbing)
-		{
-			Start1 = GetActorUpVector() * (GetCapsuleComponent()->GetScaledCapsuleHalfHeight()*2.f )+ GetActorLocation()
-				+GetActorForwardVector()*GetCapsuleComponent()->GetScaledCapsuleRadius()*2.f;
-			End1 = Start1;
-			FHitResult OutHitVault;
-			// If this capsule cast with the size of the character, does not find anything above it, the character will climb on top
-			DrawDebugLine(GetWorld(), Start1, End1, FColor::Green, false, 0.3f, 0, 2.f);
-			DrawDebugCapsule(GetWorld(),Start1,GetCapsuleComponent()->GetScaledCapsuleHalfHeight(), GetCapsuleComponent()->GetScaledCapsuleRadius(),
-			                 FQuat::Identity,FColor::Emerald, false,2.f,3,1.f);
-			if(!GetWorld()->SweepSingleByChannel(OutHitVault,Start1,End1,FQuat::Identity, ECollisionChannel::ECC_Visibility,
-			                                     FCollisionShape::MakeCapsule(GetCapsuleComponent()->GetScaledCapsuleRadius(), GetCapsuleComponent()->GetScaledCapsuleHalfHeight())))
-			{
-				FVector Location;
-				// Location is is basically the position that has been checked to be free plus a small offset forward
-				Location = Start1+ GetActorForwardVector()*30.f +GetCapsuleComponent()->GetScaledCapsuleRadius() * -2.f * GetActorForwardVector();
-				VaultUp(Location);
-			}
-			else
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Can't vault"));
-				return;
-			}
-		}
+		GetClimbingMovement()->SetWantsToClimb(false);
 	}
 }
 
-void AClimbingSystemCharacter::JumpUpWall()
-{
-	// Set movement mode to walking to use gravity
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
-
-	// Launch character up to simulate a jump
-	LaunchCharacter(GetActorUpVector() * 600.f, false, false);
-
-	// Only when the character traveled the max distance, will be able to reattach to a wall
-	bCheckForApex = true;
-}
-
-void AClimbingSystemCharacter::VaultUp(FVector Location)
-{
-	DetachFromWall();
-	FLatentActionInfo LatentInfo;
-	LatentInfo.CallbackTarget = this;
-
-	// Move the character up
-	UKismetSystemLibrary::MoveComponentTo(GetCapsuleComponent(), Location, GetActorRotation(),
-	        false, true, 0.5f, false, EMoveComponentAction::Move, LatentInfo);
-}
-
 void AClimbingSystemCharacter::JumpStart()
 {
-	GetCharacterMovement()->bNotifyApex = true;
 	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Walking)
 	{
 		ACharacter::Jump();
 	}
-	else if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Flying)
+	else if (GetClimbingMovement()->IsClimbing())
 	{
-		JumpUpWall();
+		// Jump up the wall, the character grabs it again at the apex
+		GetClimbingMovement()->RequestWallJump();
 	}
 }
 
@@ -369,9 +205,10 @@ void AClimbingSystemCharacter::MoveForward(float Value)
 		{
 			AddMovementInput(Direction, Value);
 		}
-		else if (MovementMode == EMovementMode::MOVE_Flying)
+		else if (GetClimbingMovement()->IsClimbing() || GetClimbingMovement()->IsHanging())
 		{
-			WallClimbMovement(Value, GetActorUpVector(), true);
+			// Both axes are solved together by the climbing movement, and move along the ledge while hanging
+			AddMovementInput(GetActorUpVector(), Value);
 		}
 	}
 }
@@ -393,22 +230,10 @@ void AClimbingSystemCharacter::MoveRight(float Value)
 		{
 			AddMovementInput(Direction, Value);
 		}
-		else if (MovementMode == EMovementMode::MOVE_Flying)
+		else if (GetClimbingMovement()->IsClimbing() || GetClimbingMovement()->IsHanging())
 		{
-			WallClimbMovement(Value, GetActorRightVector(), false);
+			// Both axes are solved together by the climbing movement, and move along the ledge while hanging
+			AddMovementInput(GetActorRightVector(), Value);
 		}
 	}
 }
-
-void AClimbingSystemCharacter::CharacterReachedJumpApex()
-{
-	if (bCheckForApex)
-	{
-		AttachToWall();
-	}
-}
-
-void AClimbingSystemCharacter::CharacterOnLand(const FHitResult& Hit)
-{
-	bCheckForApex = false;
-}
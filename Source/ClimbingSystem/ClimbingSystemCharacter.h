@@ -18,8 +18,11 @@ class AClimbingSystemCharacter : public ACharacter
 	/** Follow camera */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	class UCameraComponent* FollowCamera;
+
+	/** Drives the input handlers with scripted input */
+	friend class UClimbingBenchmarkCommandlet;
 public:
-	AClimbingSystemCharacter();
+	AClimbingSystemCharacter(const FObjectInitializer& ObjectInitializer);
 
 	/** Base turn rate, in deg/sec. Other scaling may affect final turn rate. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Camera)
@@ -29,18 +32,6 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Camera)
 	float BaseLookUpRate;
 
-	/** Min angle allowed to be able to climb while moving on walls */
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category=Movement, meta=(AllowPrivateAccess = "true"))
-	float MinClimbAngle;
-
-	/** Max angle allowed to be able to climb while moving on walls */
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category=Movement, meta=(AllowPrivateAccess = "true"))
-	float MaxClimbAngle;
-	
-	/** Max angle allowed to be able to turn while moving on walls */
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category=Movement, meta=(AllowPrivateAccess = "true"))
-	float MaxTurnAngle;
-
 protected:
 
 	/** Resets HMD orientation in VR. */
@@ -70,53 +61,28 @@ protected:
 	/** Handler for when a touch input stops. */
 	void TouchStopped(ETouchIndex::Type FingerIndex, FVector Location);
 
-	virtual void BeginPlay() override;
-
 protected:
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	// End of APawn interface
 
+	// UObject interface
+	virtual void PostLoad() override;
+	// End of UObject interface
+
 public:
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	/** Returns FollowCamera subobject **/
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+	/** Returns CharacterMovement subobject as the climbing movement component **/
+	class UClimbingMovementComponent* GetClimbingMovement() const;
 
 private:
 	
-	/** Try to attach the character to the wall */
-	void AttachToWall();
-
-	/** Detaches the character from the wall if he's climbing */
-	void DetachFromWall();
-
-	/** Handles the GrabWall button press */
+	/** Handles the GrabWall button press, the grab is applied by the climbing movement so it can be predicted */
 	void HandleWallGrab();
 
-	/** Performs a box trace in front of the character */
-	bool WallTrace(FHitResult& OutHit, FVector Start, FVector End, FColor Color);
-
-	/** Resets character Pitch when dropping from a wall */
-	void ResetRotation();
-
-	/** Engine of the climbing system movement
-	 * @param Axis Ranges from -1 to 1, it is the Axis input
-	 * @param Direction Vector specifying which direction the character is moving
-	 * @param bVertical True when evaluating vertical movement, false otherwise
-	 */
-	void WallClimbMovement(float Axis, FVector Direction, bool bVertical);
-
-	/** Used to jump while climbing a wall */
-	void JumpUpWall();
-
-	/** When the character reaches the top of a wall, if there is enough
-	 *  space he vaults on top, with a first movement straight up and
-	 *  then a second movement forward
-	 *  @param Location Position the character will move to
-	 */ 
-	void VaultUp(FVector Location);
-
 	/** Handles jump mechanics, with different behavior if the character is walking
 	 *  or if he is climbing a wall */
 	void JumpStart();
@@ -125,24 +91,15 @@ private:
 	 *  from ACharacter */
 	void JumpStop();
 
-	/** Called by OnReachedJumpApex when character is at maximum height in a jump,
-	 *  it is used to make the character grab a wall if he was climbing
-	 *  before the jump */
-	UFUNCTION()
-	void CharacterReachedJumpApex();
+	/** Climbing angles of the character before they moved to UClimbingMovementComponent, forwarded to it on load */
+	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="Use MinClimbAngle of the ClimbingMovementComponent"))
+	float MinClimbAngle_DEPRECATED;
 
-	/** Called by LandedDelegate when the character lands. It is used to
-	 *  reset the boolean that triggers the delegate for jump apex, bCheckForApex */
-	UFUNCTION()
-	void CharacterOnLand(const FHitResult& Hit);
-	
-	/** Should a delegate be triggered when the character reaches jump apex? */
-	bool bCheckForApex;
+	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="Use MaxClimbAngle of the ClimbingMovementComponent"))
+	float MaxClimbAngle_DEPRECATED;
 
-	/** Is the character climbing? This is set to true after the character attached
-	 *  to a wall and did some movement, to avoid he tries to climb when he just
-	 *  attached */
-	bool bClimbing;
+	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="Use MaxTurnAngle of the ClimbingMovementComponent"))
+	float MaxTurnAngle_DEPRECATED;
 
 };
 
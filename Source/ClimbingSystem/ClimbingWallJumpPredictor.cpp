@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ClimbingWallJumpPredictor.h"
+
+#include "ClimbingDebug.h"
+#include "ClimbingStats.h"
+#include "Engine/World.h"
+
+FClimbingWallJumpPredictor::FClimbingWallJumpPredictor()
+	: ApexLocation(FVector::ZeroVector)
+	, VaultLocation(FVector::ZeroVector)
+	, LedgeStart(FVector::ZeroVector)
+	, LedgeEnd(FVector::ZeroVector)
+	, Channel(ECC_WorldStatic)
+	, Outcome(EClimbingWallJumpOutcome::Pending)
+	, bActive(false)
+{
+}
+
+void FClimbingWallJumpPredictor::Reset()
+{
+	WallHandle = FTraceHandle();
+	LedgeHandle = FTraceHandle();
+	WallHit = FHitResult();
+	Outcome = EClimbingWallJumpOutcome::Pending;
+	bActive = false;
+}
+
+bool FClimbingWallJumpPredictor::Start(UWorld* World, const FClimbingWallJumpFrame& Frame, ECollisionChannel InChannel, const FCollisionQueryParams& InParams)
+{
+	check(World);
+	Reset();
+
+	Channel = InChannel;
+	Params = InParams;
+	bActive = Submit(World, Frame);
+	return bActive;
+}
+
+bool FClimbingWallJumpPredictor::Submit(UWorld* World, const FClimbingWallJumpFrame& Frame)
+{
+	// The apex is where the velocity along gravity turns around
+	const float GravitySizeSquared = Frame.Gravity.SizeSquared();
+	const float ApexTime = GravitySizeSquared > KINDA_SMALL_NUMBER ? -FVector::DotProduct(Frame.Velocity, Frame.Gravity) / GravitySizeSquared : 0.f;
+	if (ApexTime <= 0.f)
+	{
+		return false;
+	}
+
+	ApexLocation = Frame.Location + Frame.Velocity * ApexTime + 0.5f * Frame.Gravity * FMath::Square(ApexTime);
+
+	// Same boxcast as a grab in front of the climber
+	const FVector WallStart = ApexLocation;
+	const FVector WallEnd = WallStart + Frame.Forward * Frame.CapsuleRadius * 3.f;
+	ClimbingDebug::DrawProbe(World, WallStart, WallEnd, FColor::Green);
+	WallHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, WallStart, WallEnd, FQuat::Identity, Channel,
+	                                        FCollisionShape::MakeBox(FVector(0.01f, 0.01f, 0.01f)), Params);
+
+	// The capsule comes down on top of the wall from the apex, to the height the climber is at
+	const FVector OverLedge = Frame.Forward.GetSafeNormal2D() * Frame.CapsuleRadius * 3.f;
+	LedgeStart = ApexLocation + OverLedge;
+	LedgeEnd = FVector(LedgeStart.X, LedgeStart.Y, FMath::Min(Frame.Location.Z, LedgeStart.Z));
+	ClimbingDebug::DrawProbe(World, LedgeStart, LedgeEnd, FColor::Yellow);
+	LedgeHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, LedgeStart, LedgeEnd, FQuat::Identity, Channel,
+	                                         FCollisionShape::MakeCapsule(Frame.CapsuleRadius, Frame.CapsuleHalfHeight), Params);
+	CLIMBING_COUNT_SWEEPS(2);
+	return true;
+}
+
+EClimbingWallJumpOutcome FClimbingWallJumpPredictor::Update(UWorld* World, const FClimbingWallJumpFrame& Frame, float WalkableFloorZ, TFunctionRef<bool(const FHitResult&)> IsClimbable)
+{
+	check(World);
+	if (!bActive || Outcome != EClimbingWallJumpOutcome::Pending)
+	{
+		return Outcome;
+	}
+
+	FTraceDatum WallDatum;
+	FTraceDatum LedgeDatum;
+	if (!World->QueryTraceData(WallHandle, WallDatum) || !World->QueryTraceData(LedgeHandle, LedgeDatum))
+	{
+		// The results were not read in time, as on a server that got no move from the climber that frame
+		if (!World->IsTraceHandleValid(WallHandle, false) || !World->IsTraceHandleValid(LedgeHandle, false))
+		{
+			bActive = Submit(World, Frame);
+		}
+		return Outcome;
+	}
+
+	WallHandle = FTraceHandle();
+	LedgeHandle = FTraceHandle();
+
+	const bool bWallHit = WallDatum.OutHits.Num() > 0 && WallDatum.OutHits[0].bBlockingHit;
+	const bool bLedgeHit = LedgeDatum.OutHits.Num() > 0 && LedgeDatum.OutHits[0].bBlockingHit;
+	return Decide(bWallHit ? &WallDatum.OutHits[0] : nullptr, bLedgeHit ? &LedgeDatum.OutHits[0] : nullptr, WalkableFloorZ, IsClimbable);
+}
+
+EClimbingWallJumpOutcome FClimbingWallJumpPredictor::Decide(const FHitResult* WallResult, const FHitResult* LedgeResult, float WalkableFloorZ, TFunctionRef<bool(const FHitResult&)> IsClimbable)
+{
+	if (WallResult && IsClimbable(*WallResult))
+	{
+		WallHit = *WallResult;
+		Outcome = EClimbingWallJumpOutcome::Reattach;
+		return Outcome;
+	}
+
+	// A capsule starting inside the wall has no space on top of it
+	if (LedgeResult && !LedgeResult->bStartPenetrating && LedgeResult->ImpactNormal.Z >= WalkableFloorZ)
+	{
+		VaultLocation = LedgeResult->Location;
+		Outcome = EClimbingWallJumpOutcome::Vault;
+		return Outcome;
+	}
+
+	Outcome = EClimbingWallJumpOutcome::Drop;
+	return Outcome;
+}
+
+bool FClimbingWallJumpPredictor::GetWallHit(const FVector& Start, const FVector& End, FHitResult& OutHit) const
+{
+	if (!bActive || Outcome != EClimbingWallJumpOutcome::Reattach)
+	{
+		return false;
+	}
+
+	// Where the grab crosses the plane of the wall found at the apex
+	const FVector TraceDirection = End - Start;
+	const float Denominator = FVector::DotProduct(TraceDirection, WallHit.Normal);
+	if (FMath::IsNearlyZero(Denominator))
+	{
+		return false;
+	}
+
+	const float Time = FVector::DotProduct(WallHit.Location - Start, WallHit.Normal) / Denominator;
+	if (Time < 0.f || Time > 1.f)
+	{
+		return false;
+	}
+
+	const FVector Delta = Start + Time * TraceDirection - WallHit.Location;
+	OutHit = WallHit;
+	OutHit.Time = Time;
+	OutHit.Location += Delta;
+	OutHit.ImpactPoint += Delta;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.Distance = Time * TraceDirection.Size();
+	return true;
+}
+
+bool FClimbingWallJumpPredictor::IsOnLedgeProbe(const FVector& Location, float Tolerance) const
+{
+	return bActive && FMath::PointDistToSegment(Location, LedgeStart, LedgeEnd) <= Tolerance;
+}
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+
+/** Climber leaving the wall with a jump, as seen by the wall jump predictor */
+struct FClimbingWallJumpFrame
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	FVector Gravity = FVector::ZeroVector;
+
+	/** Facing of the climber, kept during the jump */
+	FVector Forward = FVector::ForwardVector;
+
+	float CapsuleRadius = 0.f;
+	float CapsuleHalfHeight = 0.f;
+};
+
+/** What the climber will find at the apex of the jump */
+enum class EClimbingWallJumpOutcome : uint8
+{
+	/** The probes did not come back yet */
+	Pending,
+	/** The wall goes on at the apex, it is grabbed there */
+	Reattach,
+	/** The wall ends below the apex, the climber vaults on top of it */
+	Vault,
+	/** Neither a wall nor a ledge with space on top, the climber lets go */
+	Drop
+};
+
+/**
+ * Predicts the ballistic path of a wall jump when it starts, and probes the apex during the ascent: a boxcast
+ * for the wall to grab at the apex and a capsule cast down on top of the wall, in case it ends before.
+ * Both are async and read back on the next frames, so the apex itself needs no queries.
+ */
+class FClimbingWallJumpPredictor
+{
+public:
+	FClimbingWallJumpPredictor();
+
+	/** Drops the prediction and the probes in flight */
+	void Reset();
+
+	/** Predicts the apex of a jump and submits its probes
+	 *  @return False if the jump never reaches an apex, the probes are not submitted then
+	 */
+	bool Start(UWorld* World, const FClimbingWallJumpFrame& Frame, ECollisionChannel InChannel, const FCollisionQueryParams& InParams);
+
+	/** Reads back the probes once they are done. Results not read on the frame after they were traced are gone,
+	 *  the probes are then submitted again from where the climber is now
+	 *  @param Frame Climber as it is now
+	 *  @param WalkableFloorZ Min Z of the normal of a floor the climber can vault on
+	 *  @param IsClimbable Can the wall of a hit be grabbed? A wall that can't is treated as no wall
+	 */
+	EClimbingWallJumpOutcome Update(UWorld* World, const FClimbingWallJumpFrame& Frame, float WalkableFloorZ, TFunctionRef<bool(const FHitResult&)> IsClimbable);
+
+	EClimbingWallJumpOutcome GetOutcome() const { return Outcome; }
+
+	/** Is there a prediction running or decided? */
+	bool IsActive() const { return bActive; }
+
+	/** Hit of a grab on the wall found at the apex, without a query. A ceiling may cut the jump short of the apex,
+	 *  the grab then lands lower on the same wall
+	 *  @return False unless the outcome is Reattach and the grab reaches the wall
+	 */
+	bool GetWallHit(const FVector& Start, const FVector& End, FHitResult& OutHit) const;
+
+	/** Location on top of the wall, valid with the Vault outcome */
+	const FVector& GetVaultLocation() const { return VaultLocation; }
+
+	/** Is a location on top of the wall one the probe down on top of it could have found? */
+	bool IsOnLedgeProbe(const FVector& Location, float Tolerance) const;
+
+	const FVector& GetApexLocation() const { return ApexLocation; }
+
+private:
+	/** Submits the probes of the apex of the jump of a climber
+	 *  @return False if the climber is past the apex
+	 */
+	bool Submit(UWorld* World, const FClimbingWallJumpFrame& Frame);
+
+	/** Picks the outcome from the first blocking hit of each probe, null if the probe hit nothing */
+	EClimbingWallJumpOutcome Decide(const FHitResult* WallResult, const FHitResult* LedgeResult, float WalkableFloorZ, TFunctionRef<bool(const FHitResult&)> IsClimbable);
+
+	FVector ApexLocation;
+	FVector VaultLocation;
+	FHitResult WallHit;
+
+	FTraceHandle WallHandle;
+	FTraceHandle LedgeHandle;
+
+	/** Segment of the probe down on top of the wall */
+	FVector LedgeStart;
+	FVector LedgeEnd;
+
+	/** Query of the probes, to submit them again */
+	ECollisionChannel Channel;
+	FCollisionQueryParams Params;
+
+	EClimbingWallJumpOutcome Outcome;
+	bool bActive;
+};